@@ -9,7 +9,8 @@ And there are some stepsto follow :
 1. Close watchdog timer
 2. Set DCO as src of MCLK, 1 MHz, and VLO as ACLK
 3. Setup both LED lights and set it initially off
-4. First set timer_A source from MCLK(DCO) to settle 30 micro second delay, and then set timer_A source from ACLK(VLO).
+4. Set timer_A source from ACLK(VLO), OUT1 triggers a conversion every second. The reference needs 30 micro second to settle,
+   the first trigger comes 1 second after REFON so no separate delay is needed (see ADC_fastBoot.c).
 5. Set ADC configuration into: 
 5.1 Sample-and-hold source from timer_A
 5.2 Temperature sensor channel
@@ -63,23 +64,12 @@ void ConfigLEDs(void) {
 
 // 4. Configure Timer_A
 void ConfigTimerA(void) {
-    //delay for 30 microsec
-    __enable_interrupt();
-    TACCR0 = 30;
-    TACCTL0 |= CCIE;
-    TACTL = TASSEL_2 | MC_1 | TACLR; //SMCLK, up mode, smclk clock sourced default is DCO ~= 1MHz , so count up to 30 ~= 30 microsec
-    __bis_SR_register(LPM0_bits + GIE);  // Enter LPM0 with global interrupts enabled
-    TACCTL0 &= ~CCIE;
-    __disable_interrupt();
-
-    // After initial setup, switch to ACLK sourced from VLO for 1-second intervals
-    __enable_interrupt();
-    TACCR1 = 12000;  // 12 kHz ACLK results in 1-second interval (12000 ticks)
-    TACCTL1 |= CCIE;
+    // The old 30 microsec wait was followed by a wait on TACCR1 that never returned (no TIMER0_A1 handler).
+    // The reference settles during the first period, so Timer_A only has to produce the trigger.
+    TACCR0 = 12000 - 1;  // 12 kHz ACLK results in 1-second interval (12000 ticks)
+    TACCTL1 = OUTMOD_3;  // OUT1 set at TACCR1, reset at TACCR0 -> rising edge triggers ADC10 (SHS_1)
+    TACCR1 = 12000 - 2;
     TACTL = TASSEL_1 | MC_1 | TACLR;  // Use ACLK (VLO ~12 kHz) as Timer_A source, up mode
-    __bis_SR_register(LPM0_bits + GIE);  // Enter LPM0 with global interrupts enabled
-    TACCTL1 &= ~CCIE;
-    __disable_interrupt();
 }
 
 // 5. Configure ADC10 for temperature sensing
@@ -112,9 +102,3 @@ __interrupt void ADC10_ISR(void) {
     tempPrevious = tempCurrent;  // Store the current reading for the next comparison
     ADC10CTL0 |= ENC | ADC10SC;  // Start the next conversion
 }
-
-#pragma vector=TIMERA0_VECTOR
-__interrupt void ta0_isr(void){
-    TACTL = ~TAIFG;
-    LPM0_EXIT;                        // Exit LPM0 on return
-}
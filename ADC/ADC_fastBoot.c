@@ -0,0 +1,178 @@
+/*
+Fast boot: measure the time from reset to the first valid temperature sample and send it to the PC.
+The internal reference needs about 30 us to settle after REFON. Instead of waiting for it in a busy loop
+(__delay_cycles(1000) in softwareUART_application3.c) the boot is split into steps that run in parallel:
+1. Clocks first, then REFON + ADC10ON and Timer0_A (SMCLK, continuous) are started together, TAR = 0 is the boot reference
+2. TA0CCR1 fires when the reference has settled, its ISR starts the first conversion by itself
+3. Meanwhile main configures the LEDs and the UART pins, then sleeps in LPM0 until the ADC10 ISR reports the sample
+4. The ADC10 ISR stores TAR, the boot-to-first-sample latency in microseconds (SMCLK = 1 MHz)
+Benchmark: build with BOOT_LEGACY defined to get the old sequential boot (delay loop, then polled conversion)
+and compare the "BOOT" line of both images. Timer0_A is started after the clock setup in both cases.
+Host model (host/, 1 MHz, register accesses 3 cycles each): BOOT_LEGACY "BOOT 1093 us", this boot "BOOT 119 us",
+i.e. 30 us of settling plus the ~64 us conversion (ADC10SHT_3, ADC10OSC / 4) instead of the 1000 cycle delay first.
+UART: 9600 baud, 8-bit data, 1 stop bit, TX on P1.1, sharing the continuous Timer0_A with the boot timing.
+*/
+
+#include "msp430.h"
+
+#define UART_TXD 0x02 // TXD on P1.1 (Timer0_A.OUT0)
+#define UART_TBIT 1000000 / 9600 // Transmission time per bit = clock/baud rate
+
+#define LED_RED BIT0    // P1.0 Red LED
+#define LED_GREEN BIT6  // P1.6 Green LED
+
+#define REF_SETTLE_TICKS 30     // 30 us at SMCLK 1 MHz
+
+#define BOOT_REF_READY 0x01     // Boot completion events
+#define BOOT_FIRST_SAMPLE 0x02
+
+unsigned int txData;  // UART internal TX variable
+volatile unsigned char bootEvents = 0;
+volatile unsigned int firstSampleTime; // TAR at the end of the first conversion
+volatile unsigned int firstSample;
+
+void configWDT(void);
+void configClocks(void);
+void configLEDs(void);
+void configP1_UART(void);
+void bootStart(void);
+void TimerA_UART_tx(unsigned char byte);
+void TimerA_UART_print(char *string);
+void TimerA_UART_printNum(unsigned int value);
+
+void main(void) {
+    configWDT();
+    configClocks();
+    bootStart();        // Reference settles from here on
+
+#ifdef BOOT_LEGACY
+    __delay_cycles(1000);               // Delay for reference to settle
+    configLEDs();
+    configP1_UART();
+    ADC10CTL0 |= ENC + ADC10SC;         // Sampling and conversion start
+    while (ADC10CTL1 & ADC10BUSY);      // Wait until conversion is complete
+    firstSampleTime = TA0R;
+    firstSample = ADC10MEM;
+    bootEvents |= BOOT_FIRST_SAMPLE;    // ADC10 ISR must not overwrite the result
+    __enable_interrupt();
+#else
+    configLEDs();       // Done while the reference settles
+    configP1_UART();
+
+    __disable_interrupt();
+    while (!(bootEvents & BOOT_FIRST_SAMPLE)) { // Sleep until the first sample is in
+        __bis_SR_register(LPM0_bits + GIE);
+        __disable_interrupt();
+    }
+    __enable_interrupt();
+#endif
+
+    P1OUT |= LED_GREEN; // Booted
+    TimerA_UART_print("BOOT ");
+    TimerA_UART_printNum(firstSampleTime);
+    TimerA_UART_print(" us TEMP ");
+    TimerA_UART_printNum(firstSample);
+    TimerA_UART_print("\r\n");
+
+    while (TA0CCTL0 & CCIE);            // Let the last character out
+    P1OUT &= ~LED_GREEN;
+    __bis_SR_register(LPM4_bits + GIE); // Done, press reset to measure again
+}
+
+void configWDT(void) {
+    WDTCTL = WDTPW | WDTHOLD; // Stop watchdog timer
+}
+
+void configClocks(void) {
+    BCSCTL1 = CALBC1_1MHZ;    // Set DCO to 1 MHz
+    DCOCTL = CALDCO_1MHZ;
+    BCSCTL3 |= LFXT1S_2;      // Set VLO as the source for ACLK (~12 kHz)
+}
+
+void configLEDs(void) {
+    P1DIR |= LED_RED + LED_GREEN;    // Set LED pins as outputs
+    P1OUT &= ~(LED_RED + LED_GREEN); // Turn off LEDs initially
+}
+
+void configP1_UART(void) {
+    P1OUT &= ~UART_TXD;
+    TA0CCTL0 = OUT;           // Set TXD idle as '1'
+    P1SEL |= UART_TXD;        // Use TXD pin
+    P1DIR |= UART_TXD;
+}
+
+// Start the reference, the ADC and the boot time base at the same time
+void bootStart(void) {
+    TA0CTL = TASSEL_2 + MC_2 + TACLR; // SMCLK, continuous mode, TAR = 0 now
+    ADC10CTL1 = INCH_10 + ADC10DIV_3; // Temp Sensor ADC10CLK/4
+    ADC10CTL0 = SREF_1 + ADC10SHT_3 + REFON + ADC10ON + ADC10IE; // Internal ref on, ADC on
+#ifndef BOOT_LEGACY
+    TA0CCR1 = REF_SETTLE_TICKS;       // Reference ready event
+    TA0CCTL1 = CCIE;
+#endif
+}
+
+void TimerA_UART_print(char *string) {
+    while (*string) TimerA_UART_tx(*string++);
+}
+
+void TimerA_UART_printNum(unsigned int value) {
+    char digits[5];
+    unsigned char i = 0;
+
+    do {
+        digits[i++] = value % 10 + '0';
+        value /= 10;
+    } while (value);
+    while (i) TimerA_UART_tx(digits[--i]);
+}
+
+void TimerA_UART_tx(unsigned char byte) {
+    while (TACCTL0 & CCIE); // Ensure last char TX'd
+
+    TA0CCR0 = TA0R;      // Current state of TA counter
+    TA0CCR0 += UART_TBIT; // One bit time till 1st bit
+    TA0CCTL0 = OUTMOD0 + CCIE; // Set TXD on EQU0, Int
+    txData = byte;       // Load char to be TXD
+    txData |= 0x100;    // Add stop bit to TXData
+    txData <<= 1;       // Add start bit
+}
+
+#pragma vector = TIMER0_A0_VECTOR  // TXD interrupt
+__interrupt void Timer_A0_ISR(void) {
+    static unsigned char txBitCnt = 10;
+    TA0CCR0 += UART_TBIT; // Set TACCR0 for next intrpt
+    if (txBitCnt == 0) {  // All bits TXed?
+        TA0CCTL0 &= ~CCIE;  // Yes, disable intrpt
+        txBitCnt = 10;      // Re-load bit counter
+    } else {
+        if (txData & 0x01) {// Check next bit to TX
+            TA0CCTL0 &= ~OUTMOD2; // TX '1' by OUTMODE0/OUT
+        } else {
+            TA0CCTL0 |= OUTMOD2; // TX '0'
+        }
+        txData >>= 1;
+        txBitCnt--;
+    }
+}
+
+#pragma vector = TIMER0_A1_VECTOR  // Reference settled
+__interrupt void Timer_A1_ISR(void) {
+    switch (__even_in_range(TA0IV, TA0IV_TAIFG)) {
+        case TA0IV_TACCR1:
+            TA0CCTL1 = 0;               // One shot
+            bootEvents |= BOOT_REF_READY;
+            ADC10CTL0 |= ENC + ADC10SC; // First conversion, no need to wake up main
+            break;
+    }
+}
+
+#pragma vector = ADC10_VECTOR
+__interrupt void ADC10_ISR(void) {
+    if (!(bootEvents & BOOT_FIRST_SAMPLE)) {
+        firstSampleTime = TA0R;         // Boot-to-first-sample latency
+        firstSample = ADC10MEM;
+        bootEvents |= BOOT_FIRST_SAMPLE;
+        __bic_SR_register_on_exit(LPM0_bits); // Wake up main loop
+    }
+}
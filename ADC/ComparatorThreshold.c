@@ -0,0 +1,62 @@
+/*
+    Threshold watch with Comparator_A+:
+    Same job as RepetitiveConversion1.c: if A1 > 0.5*Vcc, P1.0 set, else reset.
+    RepetitiveConversion1.c powers up ADC10 and wakes the CPU on every conversion only to compare ADC10MEM with 0x1FF.
+    Comparator_A+ compares P1.1 (CA1) with its internal 0.5*Vcc reference in hardware:
+    CA1 on the + terminal (P2CA4), 0.5*Vcc on the - terminal (CAREF_2 with CARSEL, TI msp430g2xx3_ca_01).
+    CAIFG is set on one edge of CAOUT only, so the ISR flips CAIES after every crossing to catch the next one.
+    No clock is needed by the comparator, the CPU sleeps in LPM4 and the ADC10 is never turned on.
+    Define CMP_FILTER to enable the CAF output filter against chatter of slow or noisy inputs.
+*/
+
+#include "msp430g2553.h"
+
+#define CMP_INPUT BIT1  // P1.1 = CA1 (A1 in RepetitiveConversion1.c)
+#define LED BIT0        // P1.0 Red LED
+
+volatile unsigned int crossings = 0;  // Number of threshold crossings seen
+
+void main(void) {
+    WDTCTL = WDTPW + WDTHOLD;    // Stop WDT
+    P1DIR |= LED;                // Set P1.0 to output
+    P1DIR &= ~CMP_INPUT;
+    CAPD |= CMP_INPUT;           // Disable the digital input buffer of the analog pin
+
+    CACTL2 = P2CA4;              // CA1 on + terminal
+#ifdef CMP_FILTER
+    CACTL2 |= CAF;               // Filter CAOUT
+#endif
+    CACTL1 = CARSEL + CAREF_2 + CAON; // 0.5*Vcc on - terminal (CARSEL), comparator on
+    __delay_cycles(10);          // Let the comparator output settle before reading it
+
+    if (CACTL2 & CAOUT) {        // Start with the current state
+        P1OUT |= LED;
+        CACTL1 |= CAIES;         // Above the threshold: wait for the falling edge
+    } else {
+        P1OUT &= ~LED;
+    }
+    CACTL1 &= ~CAIFG;
+    CACTL1 |= CAIE;              // Interrupt on crossings only
+
+    __bis_SR_register(LPM4_bits + GIE); // All clocks off, woken only by a crossing
+}
+
+// Comparator_A+ interrupt service routine
+#pragma vector=COMPARATORA_VECTOR
+__interrupt void Comparator_A_ISR(void)
+{
+    unsigned char state;
+
+    do {
+        state = CACTL2 & CAOUT;
+        if (state) {             // A1 > 0.5*Vcc
+            P1OUT |= LED;        // Set P1.0 LED on
+            CACTL1 |= CAIES;     // Next: falling edge
+        } else {
+            P1OUT &= ~LED;       // Clear P1.0 LED off
+            CACTL1 &= ~CAIES;    // Next: rising edge
+        }
+        CACTL1 &= ~CAIFG;        // Changing CAIES may set CAIFG, clear it after the switch
+    } while ((CACTL2 & CAOUT) != state); // Crossed back meanwhile, the edge would be lost
+    crossings++;
+}
@@ -5,7 +5,7 @@ If A1 > 0.5Vcc, P1.0 is set, else reset.
 Timer_A is run in up mode and its CCR1 is used to automatically trigger ADC10 conversion, while CCR0 defines the sampling period
 Use internal oscillator times sample (16x) and conversion (13x). 
 */
-#include <sp430g2553.h>
+#include <msp430g2553.h>
 
 void main(void){
     WDTCTL = WDTPW + WDTHOLD;
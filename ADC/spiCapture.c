@@ -0,0 +1,254 @@
+/*
+ * spiCapture.c
+ *
+ * Continuous sampling as in RepetitiveConversion2.c, but every sample is kept: blocks go to an external SPI
+ * flash or FRAM (driver/spimem.c) while the next block is acquired.
+ * Timer0_A in up mode raises OUT1 (OUTMOD_3) once per CAPTURE_PERIOD SMCLK cycles, SHS_1 starts a conversion of
+ * A4 (P1.4, A1 shares P1.1 with TXD) and the ADC10 ISR puts ADC10MEM into the block being filled.
+ * A block is BLOCK_BYTES: word 0 its sequence number, then the samples. Two of them in RAM, so the page program
+ * of one (WREN, 0x02 and address polled, the data from the USCIAB0TX ISR) runs while the ISR fills the other.
+ * Both blocks of 128 bytes need the 512 bytes of RAM of the G2553, -DBLOCK_BYTES=64 fits lnk_msp430g2253.cmd.
+ * A block completed while the other one is still on its way is dropped and refilled, its sequence number is
+ * skipped on the memory.
+ * 1. The sectors are erased (not with SPIMEM_FRAM)
+ * 2. write: BENCH_BLOCKS page programs back to back up to the last WIP = 0, the sustained write rate of the
+ *    memory through the driver. A sample needs 2 bytes, capture rates up to about write_Bps / 2 fit
+ * 3. capture: CAPTURE_BLOCKS blocks at CAPTURE_HZ, worst_wait = longest time a full block waited in
+ *    spimemProgram() for the page program before (WIP) and WREN
+ * 4. The sequence numbers are read back, verify_errors counts those out of order
+ * Timer1_A (SMCLK / 8, overflows counted) times the phases, the report goes out on the UART after the capture:
+ * "erase_ms,write_bytes,write_ms,write_Bps" then "capture_hz,blocks,written,dropped,worst_wait_us,capture_Bps,
+ * verify_errors", "#" lines are comments. host/examples/spiCapture.txt runs it against the flash of the model.
+ * Build with ../driver/system.c ../driver/uart.c ../driver/spi.c ../driver/spimem.c, e.g. -DCLOCK_MHZ=16
+ * -DCAPTURE_HZ=8000, -DSPIMEM_FRAM for an FRAM.
+ */
+
+#include "msp430.h"
+#include "../driver/system.h"
+#include "../driver/uart.h"
+#include "../driver/spi.h"
+#include "../driver/spimem.h"
+
+#ifndef CAPTURE_HZ
+#define CAPTURE_HZ 4000
+#endif
+#ifndef BLOCK_BYTES
+#define BLOCK_BYTES 128         // Half a flash page, a page program never crosses the page end
+#endif
+#define BLOCK_WORDS (BLOCK_BYTES / 2)
+#define CAPTURE_PERIOD (SMCLK_HZ / CAPTURE_HZ)
+#define CAPTURE_BLOCKS 128
+#define CAPTURE_ADDRESS 0x000000UL
+#define BENCH_BLOCKS 32
+#define BENCH_ADDRESS (CAPTURE_ADDRESS + (unsigned long)CAPTURE_BLOCKS * BLOCK_BYTES)
+#define ERASE_BYTES ((unsigned long)(CAPTURE_BLOCKS + BENCH_BLOCKS) * BLOCK_BYTES)
+
+#if SPIMEM_PAGE % BLOCK_BYTES
+#error "BLOCK_BYTES must divide SPIMEM_PAGE"
+#endif
+
+unsigned int block[2][BLOCK_WORDS];
+volatile unsigned char fill = 0, full, blockReady = 0, captureEnd = 0;
+volatile unsigned int generated = 0, dropped = 0;
+unsigned int nextWord = 1;
+volatile unsigned int overflows = 0;
+
+void configPorts(void);
+void startClock(void);
+unsigned long elapsed(void);
+void startCapture(void);
+unsigned int verify(unsigned int written);
+void printLong(unsigned long value);
+
+void main(void) {
+    unsigned long address, start, wait, worstWait = 0, eraseCycles, writeCycles, captureCycles;
+    unsigned int i, written = 0;
+
+    configWDT();
+    configClocks();
+    configPorts();
+    TimerA_UART_init();
+    spiInit();
+    startClock();
+    __enable_interrupt();
+
+    TimerA_UART_print("# spiCapture ");
+#ifdef SPIMEM_FRAM
+    TimerA_UART_print("fram ");
+#else
+    TimerA_UART_print("flash ");
+#endif
+    TimerA_UART_printNum(CLOCK_MHZ);
+    TimerA_UART_print(" MHz, SPI SMCLK/");
+    TimerA_UART_printNum(SPI_DIV);
+    TimerA_UART_print(", blocks of ");
+    TimerA_UART_printNum(BLOCK_BYTES);
+    TimerA_UART_print(" bytes\r\n");
+    while (!uartTxIdle(&uart0));
+
+    start = elapsed();
+    for (address = CAPTURE_ADDRESS; address < CAPTURE_ADDRESS + ERASE_BYTES; address += SPIMEM_SECTOR) {
+        spimemErase(address);
+    }
+    while (spimemBusy());
+    eraseCycles = elapsed() - start;
+
+    start = elapsed();
+    for (i = 0; i < BENCH_BLOCKS; i++) {
+        spimemProgram(BENCH_ADDRESS + (unsigned long)i * BLOCK_BYTES, (unsigned char *)block[1], BLOCK_BYTES);
+    }
+    while (spimemBusy());
+    writeCycles = elapsed() - start;
+
+    address = CAPTURE_ADDRESS;
+    start = elapsed();
+    startCapture();
+    for (;;) {
+        __disable_interrupt();
+        while (!blockReady && !captureEnd) {
+            __bis_SR_register(LPM0_bits + GIE); // SMCLK keeps the timer and the SPI running
+            __disable_interrupt();
+        }
+        __enable_interrupt();
+        if (!blockReady) {
+            break;
+        }
+        wait = elapsed();
+        spimemProgram(address, (unsigned char *)block[full], BLOCK_BYTES);
+        wait = elapsed() - wait;
+        blockReady = 0;         // After spiWrite() took the block: spiBusy() guards it from here
+        if (wait > worstWait) worstWait = wait;
+        address += BLOCK_BYTES;
+        written++;
+    }
+    while (spimemBusy());
+    captureCycles = elapsed() - start;
+
+    TimerA_UART_init();         // Timer0_A back to the UART
+    TimerA_UART_print("erase_ms,write_bytes,write_ms,write_Bps\r\n");
+    printLong(eraseCycles / (SMCLK_HZ / 1000));
+    TimerA_UART_tx(',');
+    printLong((unsigned long)BENCH_BLOCKS * BLOCK_BYTES);
+    TimerA_UART_tx(',');
+    printLong(writeCycles / (SMCLK_HZ / 1000));
+    TimerA_UART_tx(',');
+    printLong((unsigned long)BENCH_BLOCKS * BLOCK_BYTES * (SMCLK_HZ / 1000) / (writeCycles / 1000));
+    TimerA_UART_print("\r\ncapture_hz,blocks,written,dropped,worst_wait_us,capture_Bps,verify_errors\r\n");
+    printLong(CAPTURE_HZ);
+    TimerA_UART_tx(',');
+    TimerA_UART_printNum(CAPTURE_BLOCKS);
+    TimerA_UART_tx(',');
+    TimerA_UART_printNum(written);
+    TimerA_UART_tx(',');
+    TimerA_UART_printNum(dropped);
+    TimerA_UART_tx(',');
+    printLong(worstWait / CLOCK_MHZ);
+    TimerA_UART_tx(',');
+    printLong((unsigned long)written * BLOCK_BYTES * (SMCLK_HZ / 1000) / (captureCycles / 1000));
+    TimerA_UART_tx(',');
+    TimerA_UART_printNum(verify(written));
+    TimerA_UART_print("\r\n# done\r\n");
+
+    for (;;) {
+        __bis_SR_register(LPM0_bits + GIE); // Reset to run again
+    }
+}
+
+void configPorts(void) {
+    P1OUT = 0x00;               // Initialize all GPIO
+    P1DIR = 0xFF & ~(UART_RXD + BIT4); // A4 and RXD inputs
+    P2OUT = 0x00;
+    P2DIR = 0xFF;
+}
+
+// Timer1_A counts SMCLK / 8 continuously, the ISR counts its overflows
+void startClock(void) {
+    TA1CTL = TASSEL_2 + ID_3 + MC_2 + TACLR + TAIE;
+}
+
+// SMCLK cycles since startClock(), in steps of 8
+unsigned long elapsed(void) {
+    unsigned int high, low;
+
+    do {
+        high = overflows;
+        low = TA1R;
+    } while (high != overflows);
+    return ((unsigned long)high << 16 | low) << 3;
+}
+
+// Reference, A4 in repeat-single-channel mode and the OUT1 trigger
+void startCapture(void) {
+    ADC10CTL0 = SREF_1 + ADC10SHT_2 + REFON + ADC10ON + ADC10IE;
+    ADC10CTL1 = SHS_1 + CONSEQ_2 + INCH_4;
+    ADC10AE0 |= BIT4;
+    __delay_cycles(CLOCK_MHZ * 30); // Reference settling
+    block[0][0] = 0;
+    ADC10CTL0 |= ENC;
+    TA0CCTL0 = OUT;             // TXD stays idle high
+    TA0CCR0 = CAPTURE_PERIOD - 1;
+    TA0CCTL1 = OUTMOD_3;        // Set at CCR1, reset at CCR0: a rising edge per period
+    TA0CCR1 = CAPTURE_PERIOD - 2;
+    TA0CTL = TASSEL_2 + MC_1 + TACLR; // SMCLK, up mode
+}
+
+// Sequence numbers of the written blocks must rise, the dropped ones leave gaps
+unsigned int verify(unsigned int written) {
+    unsigned int i, seq, errors = 0, expected = 0;
+
+    for (i = 0; i < written; i++) {
+        spimemRead(CAPTURE_ADDRESS + (unsigned long)i * BLOCK_BYTES, (unsigned char *)&seq, 2);
+        if (seq < expected || seq >= CAPTURE_BLOCKS) {
+            errors++;
+        } else {
+            expected = seq + 1;
+        }
+    }
+    return errors;
+}
+
+// TimerA_UART_printNum for values above 65535
+void printLong(unsigned long value) {
+    char digits[10];
+    unsigned char i = 0;
+
+    do {
+        digits[i++] = value % 10 + '0';
+        value /= 10;
+    } while (value);
+    while (i) TimerA_UART_tx(digits[--i]);
+}
+
+#pragma vector = ADC10_VECTOR  // One sample
+__interrupt void ADC10_ISR(void) {
+    block[fill][nextWord] = ADC10MEM;
+    if (++nextWord < BLOCK_WORDS) {
+        return;
+    }
+    nextWord = 1;
+    if (blockReady || spiBusy()) {
+        dropped++;              // The other block is still on its way, refill this one
+    } else {
+        full = fill;
+        fill ^= 1;
+        blockReady = 1;
+        __bic_SR_register_on_exit(LPM0_bits);
+    }
+    if (++generated == CAPTURE_BLOCKS) {
+        ADC10CTL0 &= ~(ENC + ADC10IE); // Capture complete
+        TA0CTL = 0;
+        TA0CCTL1 = 0;
+        captureEnd = 1;
+        __bic_SR_register_on_exit(LPM0_bits);
+    }
+    block[fill][0] = generated;
+}
+
+#pragma vector = TIMER1_A1_VECTOR  // Timer1_A overflow
+__interrupt void Timer1_A1_ISR(void) {
+    switch (__even_in_range(TA1IV, TA1IV_TAIFG)) {
+        case TA1IV_TAIFG:
+            overflows++;
+            break;
+    }
+}
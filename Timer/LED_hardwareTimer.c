@@ -0,0 +1,67 @@
+/*
+ * LED_hardwareTimer.c
+ *
+ * Flash the green LED without the CPU.
+ * SMCLK_DCO.c and SMCLK_overflow-1/2.c poll TAIFG and toggle P1OUT, so the CPU stays in active mode only to blink a LED.
+ * P1.6 is also TA0.1, the output unit of Timer_A CCR1 (P1SEL.6 = 1, P1SEL2.6 = 0), so the timer can drive the pin itself:
+ *   duty 50 %   : OUTMOD_4 toggle, OUT1 toggles at TACCR1 once per timer period -> LED frequency = timer frequency / 2
+ *   other duty  : OUTMOD_7 reset/set, OUT1 set at TACCR0 (period start) and reset at TACCR1 -> duty = TACCR1 / (TACCR0 + 1)
+ *   0 % / 100 % : OUTMOD_0, OUT1 follows the OUT bit
+ * Timer_A counts ACLK (VLO) in up mode, so the CPU sleeps in LPM3 while the LED blinks or dims.
+ * ledSet(frequency in Hz, duty in percent), e.g. ledSet(1, 50) blinks at 1 Hz, ledSet(100, 10) dims the LED to 10 %.
+ * P1.0 (red LED) is not connected to a timer output and cannot be driven this way.
+ */
+
+#include <msp430.h>
+
+#define GREEN_LED BIT6  // P1.6 Green LED = TA0.1
+#define ACLK_HZ 12000   // VLO, see VLO_calibration.c for a calibrated value
+
+void ledSet(unsigned int frequency, unsigned char duty);
+
+void main(void)
+{
+    WDTCTL = WDTPW | WDTHOLD;   // Stop the Watchdog timer
+    BCSCTL3 |= LFXT1S_2;        // Set VLO as the source for ACLK (~12 kHz)
+
+    P1DIR |= GREEN_LED;         // P1.6 output
+    P1SEL |= GREEN_LED;         // P1.6 driven by TA0.1 instead of P1OUT
+    P1SEL2 &= ~GREEN_LED;
+
+    ledSet(1, 50);              // Blink at 1 Hz
+
+    __bis_SR_register(LPM3_bits); // Nothing left for the CPU, only ACLK keeps running
+}
+
+// Set the LED blink frequency (1 Hz .. ACLK_HZ / 2, ACLK_HZ / 4 at 50 %) and the on-time in percent
+void ledSet(unsigned int frequency, unsigned char duty)
+{
+    unsigned int period;
+
+    if (frequency == 0) {
+        frequency = 1;
+    } else if (duty == 50 && frequency > ACLK_HZ / 4) {
+        frequency = ACLK_HZ / 4;  // Toggle mode needs TACCR0 >= 1, TACCR0 = 0 stops the timer
+    } else if (frequency > ACLK_HZ / 2) {
+        frequency = ACLK_HZ / 2;
+    }
+    period = ACLK_HZ / frequency;  // ACLK ticks per LED period
+
+    TACTL = TACLR;              // Stop the timer while it is reprogrammed
+    if (duty == 0) {
+        TACCTL1 = OUTMOD_0;     // OUT1 = OUT bit = 0, LED off
+        return;
+    } else if (duty >= 100) {
+        TACCTL1 = OUTMOD_0 + OUT; // OUT1 = 1, LED on
+        return;
+    } else if (duty == 50) {
+        TACCR0 = period / 2 - 1;  // Two toggles per LED period
+        TACCR1 = 0;
+        TACCTL1 = OUTMOD_4;     // Toggle
+    } else {
+        TACCR0 = period - 1;
+        TACCR1 = (unsigned int)(((unsigned long)period * duty) / 100);
+        TACCTL1 = OUTMOD_7;     // Reset/set
+    }
+    TACTL = TASSEL_1 + MC_1 + TACLR;  // ACLK, up mode
+}
@@ -0,0 +1,106 @@
+/*
+ * VLO_calibration.c
+ *
+ * Measure the temperature every second with the timing taken from ACLK (VLO) so the CPU can sleep in LPM3.
+ * The VLO is only nominally 12 kHz, it drifts between about 4 kHz and 20 kHz with temperature and Vcc,
+ * so TACCR0 = 12000 is not one second. Calibrate the VLO against the calibrated 1 MHz DCO instead:
+ * 1. Divide ACLK by 8 and let Timer_A count SMCLK (DCO 1 MHz) in continuous mode
+ * 2. Capture TAR on every rising edge of ACLK through CCI0B (CCIS_1 = ACLK inside the chip)
+ * 3. The SMCLK counts between captures give the VLO frequency: vlo = 1 MHz * 8 * periods / counts
+ * 4. Use the corrected value as the 1 second period of Timer_A in up mode from ACLK
+ * The calibration runs at boot and again every VLO_CAL_INTERVAL seconds to follow the drift, a result outside
+ * 4 .. 20 kHz (ACLK not running, a disturbed capture) keeps the previous value, 12000 until the first good one.
+ * Flash the red LED if the temperature rises and the green LED if it drops, toggle both if it is unchanged.
+ * Build with ../driver/system.c ../driver/vlo.c.
+ */
+
+#include "msp430.h"
+#include "../driver/system.h"
+#include "../driver/vlo.h"
+
+#define LED_RED BIT0    // P1.0 Red LED
+#define LED_GREEN BIT6  // P1.6 Green LED
+
+#define VLO_CAL_INTERVAL 60     // Seconds between two calibrations
+
+volatile unsigned int vloTicksPerSecond = VLO_NOMINAL_HZ; // Corrected ACLK ticks per second
+volatile unsigned int tempPrevious = 0; // Store previous temperature reading
+
+void configLEDs(void);
+void configADC10(void);
+void configTimerA_1s(void);
+void calibrateVLO(void);
+unsigned int readTemperature(void);
+
+void main(void) {
+    unsigned int seconds = 0;
+    unsigned int tempCurrent;
+
+    configWDT();
+    configClocks();
+    configLEDs();
+    configADC10();
+
+    calibrateVLO();                     // Calibrate once at boot
+    configTimerA_1s();
+    tempPrevious = readTemperature();
+    __enable_interrupt();
+
+    for (;;) {
+        __bis_SR_register(LPM3_bits + GIE); // Sleep until the next second, only ACLK keeps running
+
+        tempCurrent = readTemperature();
+        if (tempCurrent > tempPrevious) {
+            P1OUT = (P1OUT & ~LED_GREEN) | LED_RED; // Temperature increased
+        } else if (tempCurrent < tempPrevious) {
+            P1OUT = (P1OUT & ~LED_RED) | LED_GREEN; // Temperature decreased
+        } else {
+            P1OUT ^= LED_RED + LED_GREEN; // Temperature unchanged, toggle both
+        }
+        tempPrevious = tempCurrent;
+
+        if (++seconds >= VLO_CAL_INTERVAL) { // Time to follow the VLO drift
+            seconds = 0;
+            calibrateVLO();
+            configTimerA_1s();
+        }
+    }
+}
+
+void configLEDs(void) {
+    P1DIR |= LED_RED + LED_GREEN;    // Set LED pins as outputs
+    P1OUT &= ~(LED_RED + LED_GREEN); // Turn off LEDs initially
+}
+
+void configADC10(void) {
+    ADC10CTL1 = INCH_10 + ADC10DIV_3; // Temp Sensor ADC10CLK/4
+    ADC10CTL0 = SREF_1 + ADC10SHT_3 + REFON + ADC10ON; // Internal ref on, ADC on
+}
+
+// Timer_A from ACLK in up mode, CCR0 interrupt once per corrected second
+void configTimerA_1s(void) {
+    TA0CTL = TACLR;                     // Stop and clear the timer
+    TA0CCR0 = vloTicksPerSecond - 1;    // Count from 0 to CCR0 -> CCR0 + 1 ticks
+    TA0CCTL0 = CCIE;                    // Compare mode, interrupt on CCR0
+    TA0CTL = TASSEL_1 + MC_1;           // ACLK, up mode
+}
+
+// New ticks per second, a failed calibration keeps the last value
+void calibrateVLO(void) {
+    unsigned int hz = vloCalibrate();
+
+    if (hz) {
+        vloTicksPerSecond = hz;
+    }
+}
+
+unsigned int readTemperature(void) {
+    ADC10CTL0 |= ENC + ADC10SC;         // Sampling and conversion start
+    while (ADC10CTL1 & ADC10BUSY);      // Wait until conversion is complete
+    return ADC10MEM;
+}
+
+#pragma vector = TIMER0_A0_VECTOR       // One corrected second elapsed
+__interrupt void Timer_A0_ISR(void) {
+    __bic_SR_register_on_exit(LPM3_bits); // Wake up main loop
+}
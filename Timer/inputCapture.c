@@ -0,0 +1,278 @@
+/*
+ * inputCapture.c
+ *
+ * Measure frequency, period and duty cycle of an external signal with Timer_A capture and send them to the PC.
+ * MCLK = SMCLK = DCO 16 MHz. Two modes, chosen automatically:
+ * 1. Edge mode (signals up to about EDGE_MAX_HZ): the signal on P2.1 (TA1.CCI1A) is captured on both edges (CM_3).
+ *    Rising edges give the period, falling edges the high time. The direction of a capture follows by parity from
+ *    the input level read when capturing starts: CCI in a late ISR may already show the level after the next edge.
+ *    An edge captured before the ISR read the previous one (COV, or CCIFG set again) restarts the measurement. Timer1_A overflows (TAIFG) extend the 16-bit
+ *    capture to 32 bits, so slow signals down to about 10 Hz work too. AVG_PERIODS periods are averaged.
+ * 2. Gated mode (faster signals, up to several hundred kHz): the same signal on P1.0 (TA0CLK) clocks Timer0_A,
+ *    Timer1_A CCR2 opens and closes a GATE_MS window, edges in the window = frequency. No interrupt per edge.
+ * The CPU never polls the pin, it sleeps in LPM0 until a measurement is complete.
+ * Wiring: signal to P2.1 and P1.0 (remove the red LED jumper), P2.0 to the TXD line of the LaunchPad UART.
+ * UART: 9600 baud, 8-bit data, 1 stop bit on P2.0, the driver's uart1. Timer0_A is taken by the gated mode, so the
+ * bits come from Timer1_A CCR0 and its OUT0 pin, the capture uses CCR1/CCR2 of the same continuous SMCLK count.
+ * Output: "F <Hz> T <us> D <%>" in edge mode, "F <Hz> GATED" in gated mode.
+ * Build with ../driver/system.c ../driver/uart.c and -DCLOCK_MHZ=16 -DUART1 (no UART_RX: CCR1 captures the signal).
+ */
+
+#include <msp430.h>
+#include "../driver/system.h"
+#include "../driver/uart.h"
+
+#if CLOCK_MHZ != 16 || !defined(UART1) || defined(UART_RX)
+#error "inputCapture.c needs -DCLOCK_MHZ=16 -DUART1 and no UART_RX"
+#endif
+
+#define CAPTURE_IN BIT1         // P2.1 = TA1.CCI1A
+#define COUNT_IN BIT0           // P1.0 = TA0CLK
+
+#define AVG_PERIODS 16          // Periods averaged in edge mode
+#define EDGE_MAX_HZ 50000UL     // Faster signals are measured in gated mode
+#define GATE_TICK 16000         // 1 ms of SMCLK
+#define GATE_MS 100             // Gate time in gated mode
+#define EDGE_TIMEOUT_MS 2000    // No result in edge mode -> try gated mode
+
+#define MODE_IDLE 0
+#define MODE_EDGE 1
+#define MODE_GATED 2
+
+volatile unsigned int t1Overflows = 0;  // Upper word of the Timer1_A time base
+volatile unsigned int t0Overflows = 0;  // Upper word of the edge counter
+volatile unsigned char mode = MODE_IDLE;
+volatile unsigned char done = 0;
+
+// Edge mode state
+unsigned char edgeStarted;
+unsigned char nextRising;       // Direction of the next capture
+unsigned char periods;
+unsigned long firstRise, lastRise, highSum;
+volatile unsigned long edgeTotal, edgeHigh; // Result: cycles of AVG_PERIODS periods and of their high time
+
+// Gated mode state
+volatile unsigned int gateMs;
+volatile unsigned long gateCount;       // Result: edges in GATE_MS
+
+void configPins(void);
+unsigned char edgeArm(void);
+void startEdge(void);
+void startGated(void);
+void waitDone(void);
+void reportEdge(void);
+void reportGated(void);
+void printLong(unsigned long value);
+
+void main(void)
+{
+    configWDT();
+    configClocks();
+    configPins();
+    TimerA1_UART_init();
+    TA1CTL = TASSEL_2 + MC_2 + TACLR + TAIE; // SMCLK, continuous mode, overflow interrupt
+    __enable_interrupt();
+    uartPrint(&uart1, "Input capture READY.\r\n");
+
+    for (;;) {
+        startEdge();
+        waitDone();
+        if (edgeTotal && edgeTotal / AVG_PERIODS >= SMCLK_HZ / EDGE_MAX_HZ) {
+            reportEdge();
+        } else {                // Too fast for one interrupt per edge, or no signal on P2.1
+            startGated();
+            waitDone();
+            reportGated();
+        }
+    }
+}
+
+void configPins(void) {
+    P1SEL = COUNT_IN;           // P1.0 as TA0CLK
+    P2DIR &= ~CAPTURE_IN;
+    P2SEL |= CAPTURE_IN;        // P2.1 as TA1.CCI1A
+}
+
+// Sleep until the running measurement is complete
+void waitDone(void) {
+    __disable_interrupt();
+    while (!done) {
+        __bis_SR_register(LPM0_bits + GIE);
+        __disable_interrupt();
+    }
+    __enable_interrupt();
+}
+
+void startEdge(void) {
+    __disable_interrupt();
+    edgeStarted = 0;
+    edgeTotal = 0;
+    gateMs = 0;
+    done = 0;
+    mode = MODE_EDGE;
+    TA1CCR2 = TA1R + GATE_TICK; // Timeout tick
+    TA1CCTL2 = CCIE;
+    if (!edgeArm()) {           // Changing too fast for edge mode
+        TA1CCTL2 = 0;
+        mode = MODE_IDLE;
+        done = 1;
+    }
+    __enable_interrupt();
+}
+
+// Capture both edges starting from a known input level, 0 if the input kept changing meanwhile
+unsigned char edgeArm(void) {
+    unsigned char tries;
+
+    for (tries = 0; tries < 8; tries++) {
+        TA1CCTL1 = CM_3 + CCIS_0 + SCS + CAP; // Both edges, CCI1A, synchronous capture, flags cleared
+        nextRising = !(TA1CCTL1 & CCI);
+        if (!(TA1CCTL1 & CCIFG)) { // No edge before the level was read
+            TA1CCTL1 |= CCIE;
+            return 1;
+        }
+    }
+    TA1CCTL1 = 0;
+    return 0;
+}
+
+void startGated(void) {
+    __disable_interrupt();
+    gateMs = 0;
+    done = 0;
+    mode = MODE_GATED;
+    TA0CTL = TACLR;             // Counter ready, started by the first gate tick
+    TA1CCR2 = TA1R + GATE_TICK;
+    TA1CCTL2 = CCIE;
+    __enable_interrupt();
+}
+
+void reportEdge(void) {
+    unsigned long frequency, periodTenthUs, dutyPermille, total = edgeTotal, high = edgeHigh;
+
+    frequency = (SMCLK_HZ * AVG_PERIODS + edgeTotal / 2) / edgeTotal;
+    periodTenthUs = (edgeTotal * 10) / (16 * AVG_PERIODS); // 16 cycles per us
+    while (total >= 0x400000UL) { // high * 1000 must fit 32 bits, slow signals lose only low bits
+        total >>= 1;
+        high >>= 1;
+    }
+    dutyPermille = (high * 1000 + total / 2) / total;
+    uartPrint(&uart1, "F ");
+    printLong(frequency);
+    uartPrint(&uart1, " T ");
+    printLong(periodTenthUs / 10);
+    uartTx(&uart1, '.');
+    uartTx(&uart1, periodTenthUs % 10 + '0');
+    uartPrint(&uart1, " D ");
+    printLong(dutyPermille / 10);
+    uartTx(&uart1, '.');
+    uartTx(&uart1, dutyPermille % 10 + '0');
+    uartPrint(&uart1, "\r\n");
+}
+
+void reportGated(void) {
+    uartPrint(&uart1, "F ");
+    printLong(gateCount * (1000 / GATE_MS));
+    uartPrint(&uart1, " GATED\r\n");
+}
+
+void printLong(unsigned long value) {
+    char digits[10];
+    unsigned char i = 0;
+
+    do {
+        digits[i++] = value % 10 + '0';
+        value /= 10;
+    } while (value);
+    while (i) uartTx(&uart1, digits[--i]);
+}
+
+#pragma vector = TIMER1_A1_VECTOR  // Capture, gate tick and time base overflow
+__interrupt void Timer1_A1_ISR(void) {
+    unsigned int capture, high;
+    unsigned long now;
+    unsigned char rising;
+
+    switch (__even_in_range(TA1IV, TA1IV_TAIFG)) {
+        case TA1IV_TACCR1:      // Edge on P2.1
+            capture = TA1CCR1;
+            high = t1Overflows;
+            if ((TA1CTL & TAIFG) && capture < 0x8000) { // Overflow before the capture, not yet served
+                high++;
+            }
+            now = ((unsigned long)high << 16) | capture;
+            if (TA1CCTL1 & (COV + CCIFG)) { // Next edge already captured: the parity is lost, start over
+                edgeStarted = 0;
+                if (!edgeArm()) {
+                    TA1CCTL2 = 0;
+                    mode = MODE_IDLE;
+                    done = 1;
+                    __bic_SR_register_on_exit(LPM0_bits);
+                }
+                break;
+            }
+            rising = nextRising;
+            nextRising ^= 1;
+            if (rising) {
+                if (!edgeStarted) {
+                    edgeStarted = 1;
+                    firstRise = now;
+                    periods = 0;
+                    highSum = 0;
+                } else if (++periods == AVG_PERIODS) {
+                    TA1CCTL1 = 0;   // Stop capturing
+                    TA1CCTL2 = 0;
+                    edgeTotal = now - firstRise;
+                    edgeHigh = highSum;
+                    mode = MODE_IDLE;
+                    done = 1;
+                    __bic_SR_register_on_exit(LPM0_bits);
+                }
+                lastRise = now;
+            } else if (edgeStarted) { // Falling edge closes a high phase
+                highSum += now - lastRise;
+            }
+            break;
+        case TA1IV_TACCR2:      // 1 ms tick
+            TA1CCR2 += GATE_TICK;
+            gateMs++;
+            if (mode == MODE_EDGE) {
+                if (gateMs >= EDGE_TIMEOUT_MS) { // No complete measurement, edgeTotal stays 0
+                    TA1CCTL1 = 0;
+                    TA1CCTL2 = 0;
+                    mode = MODE_IDLE;
+                    done = 1;
+                    __bic_SR_register_on_exit(LPM0_bits);
+                }
+            } else if (mode == MODE_GATED) {
+                if (gateMs == 1) {  // Open the gate on a tick so both ends see the same latency
+                    t0Overflows = 0;
+                    TA0CTL = TASSEL_0 + MC_2 + TACLR + TAIE; // TA0CLK, continuous mode
+                } else if (gateMs == GATE_MS + 1) {
+                    TA0CTL &= ~(MC_2 + TAIE); // Close the gate, TA0R is stable now
+                    gateCount = ((unsigned long)t0Overflows << 16) | TA0R;
+                    if (TA0CTL & TAIFG) {   // Overflow in the last instructions of the gate
+                        gateCount += 0x10000UL;
+                        TA0CTL &= ~TAIFG;
+                    }
+                    TA1CCTL2 = 0;
+                    mode = MODE_IDLE;
+                    done = 1;
+                    __bic_SR_register_on_exit(LPM0_bits);
+                }
+            }
+            break;
+        case TA1IV_TAIFG:
+            t1Overflows++;
+            break;
+    }
+}
+
+#pragma vector = TIMER0_A1_VECTOR  // Edge counter overflow in gated mode
+__interrupt void Timer0_A1_ISR(void) {
+    switch (__even_in_range(TA0IV, TA0IV_TAIFG)) {
+        case TA0IV_TAIFG:
+            t0Overflows++;
+            break;
+    }
+}
@@ -0,0 +1,184 @@
+/*
+ * softwarePWM.c
+ *
+ * Dim PWM_CHANNELS indicators on P1/P2 with a single Timer_A compare register.
+ * Timer_A has only three CCRs, so hardware PWM reaches two or three pins. Here every channel is a GPIO:
+ * 1. pwmSetDuty() stores the duty of a channel in steps (0 .. PWM_STEPS), pwmUpdate() turns the duties into a schedule
+ * 2. A schedule is the list of the distinct switch-off times of one period, sorted by insertion.
+ *    Channels that switch off in the same step are merged into one entry with one mask per port,
+ *    so they are cleared by a single P1OUT/P2OUT write.
+ * 3. TA0CCR0 (continuous mode, SMCLK) is always programmed to the next entry. At the period start all channels
+ *    with a duty > 0 are switched on with one write per port.
+ * Interrupts per period = distinct switch-off times + 1, independent of the number of channels and of PWM_STEPS.
+ * Two schedules are kept: the ISR runs the active one, pwmUpdate() fills the other one and the ISR swaps them
+ * at the next period start, so a new duty never produces a broken period.
+ * Period: PWM_STEPS * PWM_TICK = 100 * 100 us = 10 ms (100 Hz), channel 0 breathes, the others stay fixed.
+ */
+
+#include <msp430.h>
+
+#define PWM_CHANNELS 8
+#define PWM_STEPS 100           // Duty resolution, 100 = 1 %
+#define PWM_TICK 100            // SMCLK cycles per step, 100 us at 1 MHz
+#define PWM_PERIOD (PWM_STEPS * PWM_TICK)
+#define PWM_UPDATE_PERIODS 5    // Wake up main every 50 ms
+
+struct pwmSchedule {
+    unsigned char on1, on2;     // Channels switched on at the period start (P1, P2)
+    unsigned char count;        // Number of switch-off entries
+    unsigned char step[PWM_CHANNELS]; // Switch-off time in steps, ascending
+    unsigned char off1[PWM_CHANNELS]; // Channels switched off at that time (P1, P2)
+    unsigned char off2[PWM_CHANNELS];
+};
+
+// Port (1 or 2) and bit of every channel
+static const unsigned char pwmPort[PWM_CHANNELS] = {1, 1, 2, 2, 2, 2, 2, 2};
+static const unsigned char pwmBit[PWM_CHANNELS] = {BIT0, BIT6, BIT0, BIT1, BIT2, BIT3, BIT4, BIT5};
+
+unsigned char pwmDuty[PWM_CHANNELS];
+struct pwmSchedule pwmSchedules[2];
+volatile unsigned char pwmActive = 0;   // Schedule used by the ISR
+volatile unsigned char pwmPending = 0;  // The other schedule is ready, swap at the next period start
+
+void configWDT(void);
+void configClocks(void);
+void pwmInit(void);
+void pwmSetDuty(unsigned char channel, unsigned char duty);
+void pwmUpdate(void);
+
+void main(void)
+{
+    unsigned char ch, level = 0;
+    signed char direction = 1;
+
+    configWDT();
+    configClocks();
+    for (ch = 1; ch < PWM_CHANNELS; ch++) {
+        pwmSetDuty(ch, ch * 12);  // Fixed levels, 12 % .. 84 %
+    }
+    pwmSetDuty(2, 36);            // Same step as channel 3 -> merged edge
+    pwmInit();
+    __enable_interrupt();
+
+    for (;;) {
+        __bis_SR_register(LPM0_bits + GIE); // Woken every PWM_UPDATE_PERIODS periods
+        level += direction;
+        if (level == 0 || level == PWM_STEPS) {
+            direction = -direction;
+        }
+        pwmSetDuty(0, level);   // Breathing red LED
+        pwmUpdate();
+    }
+}
+
+void configWDT(void) {
+    WDTCTL = WDTPW | WDTHOLD; // Stop watchdog timer
+}
+
+void configClocks(void) {
+    BCSCTL1 = CALBC1_1MHZ;    // Set DCO to 1 MHz
+    DCOCTL = CALDCO_1MHZ;
+}
+
+void pwmInit(void) {
+    unsigned char ch;
+
+    for (ch = 0; ch < PWM_CHANNELS; ch++) {
+        if (pwmPort[ch] == 1) {
+            P1DIR |= pwmBit[ch];
+            P1OUT &= ~pwmBit[ch];
+        } else {
+            P2SEL &= ~pwmBit[ch];
+            P2DIR |= pwmBit[ch];
+            P2OUT &= ~pwmBit[ch];
+        }
+    }
+    pwmUpdate();
+    pwmActive ^= 1;             // Start with the fresh schedule
+    pwmPending = 0;
+
+    TA0CCR0 = PWM_PERIOD;       // First period start
+    TA0CCTL0 = CCIE;
+    TA0CTL = TASSEL_2 + MC_2 + TACLR; // SMCLK, continuous mode
+}
+
+void pwmSetDuty(unsigned char channel, unsigned char duty) {
+    pwmDuty[channel] = duty > PWM_STEPS ? PWM_STEPS : duty;
+}
+
+// Build the schedule for the current duties, it becomes active at the next period start
+void pwmUpdate(void) {
+    struct pwmSchedule *s;
+    unsigned char ch, i, j, duty, mask1, mask2;
+
+    while (pwmPending);         // The previous update has not been taken yet
+    s = &pwmSchedules[pwmActive ^ 1];
+    s->on1 = 0;
+    s->on2 = 0;
+    s->count = 0;
+
+    for (ch = 0; ch < PWM_CHANNELS; ch++) {
+        duty = pwmDuty[ch];
+        if (duty == 0) {
+            continue;           // Never on
+        }
+        mask1 = pwmPort[ch] == 1 ? pwmBit[ch] : 0;
+        mask2 = pwmPort[ch] == 2 ? pwmBit[ch] : 0;
+        s->on1 |= mask1;
+        s->on2 |= mask2;
+        if (duty == PWM_STEPS) {
+            continue;           // Never off
+        }
+
+        for (i = 0; i < s->count && s->step[i] < duty; i++);
+        if (i < s->count && s->step[i] == duty) { // Same step, one port write for both
+            s->off1[i] |= mask1;
+            s->off2[i] |= mask2;
+            continue;
+        }
+        for (j = s->count; j > i; j--) { // Make room, keep the list sorted
+            s->step[j] = s->step[j - 1];
+            s->off1[j] = s->off1[j - 1];
+            s->off2[j] = s->off2[j - 1];
+        }
+        s->step[i] = duty;
+        s->off1[i] = mask1;
+        s->off2[i] = mask2;
+        s->count++;
+    }
+    pwmPending = 1;
+}
+
+#pragma vector = TIMER0_A0_VECTOR
+__interrupt void Timer_A0_ISR(void) {
+    static unsigned char next = 0;      // Next entry of the schedule
+    static unsigned int periodStart = PWM_PERIOD;
+    static unsigned char periods = 0;
+    struct pwmSchedule *s = &pwmSchedules[pwmActive];
+
+    if (next < s->count) {              // Switch-off edge
+        P1OUT &= ~s->off1[next];
+        P2OUT &= ~s->off2[next];
+        next++;
+    } else {                            // Period start
+        if (pwmPending) {
+            pwmActive ^= 1;
+            pwmPending = 0;
+            s = &pwmSchedules[pwmActive];
+        }
+        P1OUT |= s->on1;
+        P2OUT |= s->on2;
+        next = 0;
+        periodStart = TA0CCR0;
+        if (++periods >= PWM_UPDATE_PERIODS) {
+            periods = 0;
+            __bic_SR_register_on_exit(LPM0_bits); // Time for main to change the duties
+        }
+    }
+
+    if (next < s->count) {
+        TA0CCR0 = periodStart + s->step[next] * PWM_TICK;
+    } else {
+        TA0CCR0 = periodStart + PWM_PERIOD;
+    }
+}
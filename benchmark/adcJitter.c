@@ -0,0 +1,158 @@
+/*
+ * adcJitter.c
+ *
+ * Spacing of Timer_A triggered ADC10 conversions under CPU load, measured with driver/adcjitter.c.
+ * The sampling is the one of ADC/ADC_application1.c: Timer0_A from ACLK (VLO) in up mode, OUT1 (OUTMOD_3) starts
+ * a conversion of the temperature sensor (INCH_10, CONSEQ_2) every SAMPLE_TICKS ticks, ~1 kHz by default. The
+ * ADC10 ISR stamps the completion, then reads ADC10MEM.
+ * The load is the WDT interval ISR (SMCLK / 8192, a higher priority than ADC10) busy for LOAD_CYCLES each time,
+ * LOAD_CYCLES / 8192 of the CPU. A burst longer than the sampling period costs results, rebuild with other
+ * SAMPLE_TICKS and LOAD_CYCLES to find the rate the load still allows.
+ * After JITTER_SAMPLES completions the sampling stops and the report goes out on the UART (Timer0_A again):
+ * "rate_hz,periods,late,mean_cycles,stddev_cycles,min_cycles,max_cycles,worst_us,delay_ticks,lost",
+ * "#" lines are comments. rate_hz = SMCLK_HZ / mean is the real sample rate (the VLO is anything from 4 to 20 kHz),
+ * worst_us the largest distance of a period from the mean, delay_ticks the longest trigger to ISR in VLO ticks.
+ * host/examples/adcJitter.txt lets the VLO drift in the host model.
+ * Build with ../driver/system.c ../driver/uart.c ../driver/adcjitter.c, e.g. -DCLOCK_MHZ=8 -DLOAD_CYCLES=2000.
+ */
+
+#include "msp430.h"
+#include "../driver/system.h"
+#include "../driver/uart.h"
+#include "../driver/adcjitter.h"
+
+#ifndef SAMPLE_TICKS
+#define SAMPLE_TICKS 12         // VLO ticks per sample
+#endif
+#ifndef LOAD_CYCLES
+#define LOAD_CYCLES 0
+#endif
+#define JITTER_SAMPLES 2000
+
+volatile unsigned int served = 0, temperature;
+volatile unsigned char runDone = 0;
+
+void configP1(void);
+void startSampling(void);
+void report(struct jitterStats *s);
+void printLong(unsigned long value);
+
+void main(void) {
+    struct jitterStats stats;
+
+    configWDT();
+    configClocks();
+    configP1();
+    TimerA_UART_init();
+    __enable_interrupt();
+
+    TimerA_UART_print("# adcJitter ");
+    TimerA_UART_printNum(CLOCK_MHZ);
+    TimerA_UART_print(" MHz, INCH_10 every ");
+    TimerA_UART_printNum(SAMPLE_TICKS);
+    TimerA_UART_print(" VLO ticks, load ");
+    TimerA_UART_printNum(LOAD_CYCLES);
+    TimerA_UART_print(" of 8192 cycles\r\n");
+    while (!uartTxIdle(&uart0));
+
+    startSampling();
+    jitterStart();
+#if LOAD_CYCLES
+    WDTCTL = WDT_MDLY_8;        // Interval timer, SMCLK / 8192
+    IE1 |= WDTIE;
+#endif
+
+    while (!runDone) {
+        __bis_SR_register(LPM0_bits + GIE); // SMCLK keeps the reference running
+        jitterUpdate();
+    }
+    WDTCTL = WDTPW + WDTHOLD;
+    jitterStop(&stats);
+
+    TimerA_UART_init();         // Timer0_A back to the UART
+    report(&stats);
+
+    for (;;) {
+        __bis_SR_register(LPM0_bits + GIE); // Reset to run again
+    }
+}
+
+void configP1(void) {
+    P1OUT = 0x00;               // Initialize all GPIO
+    P1DIR = 0xFF & ~UART_RXD;   // Set pins to output
+}
+
+// Timer0_A OUT1 triggers the temperature sensor every SAMPLE_TICKS of ACLK
+void startSampling(void) {
+    ADC10CTL1 = INCH_10 + SHS_1 + CONSEQ_2;
+    ADC10CTL0 = SREF_1 + ADC10SHT_2 + REFON + ADC10ON + ADC10IE;
+    ADC10CTL0 |= ENC;           // The reference settles before the first trigger
+    TA0CCTL0 = OUT;             // TXD stays idle high
+    TA0CCR0 = SAMPLE_TICKS - 1;
+    TA0CCTL1 = OUTMOD_3;        // Set at CCR1, reset at CCR0: a rising edge per period
+    TA0CCR1 = SAMPLE_TICKS - 2;
+    TA0CTL = TASSEL_1 + MC_1 + TACLR; // ACLK, up mode
+}
+
+void report(struct jitterStats *s) {
+    unsigned long worst = s->max > s->mean ? s->max - s->mean : 0;
+
+    if (s->periods && s->mean > s->min && s->mean - s->min > worst) {
+        worst = s->mean - s->min;
+    }
+
+    TimerA_UART_print("rate_hz,periods,late,mean_cycles,stddev_cycles,min_cycles,max_cycles,worst_us,delay_ticks,"
+                      "lost\r\n");
+    printLong(s->mean ? SMCLK_HZ / s->mean : 0);
+    TimerA_UART_tx(',');
+    printLong(s->periods);
+    TimerA_UART_tx(',');
+    printLong(s->late);
+    TimerA_UART_tx(',');
+    printLong(s->mean);
+    TimerA_UART_tx(',');
+    printLong(s->stddev);
+    TimerA_UART_tx(',');
+    printLong(s->min);
+    TimerA_UART_tx(',');
+    printLong(s->max);
+    TimerA_UART_tx(',');
+    printLong(worst / CLOCK_MHZ);
+    TimerA_UART_tx(',');
+    TimerA_UART_printNum(s->delay);
+    TimerA_UART_tx(',');
+    TimerA_UART_printNum(s->lost);
+    TimerA_UART_print("\r\n# done\r\n");
+}
+
+// TimerA_UART_printNum for values above 65535
+void printLong(unsigned long value) {
+    char digits[10];
+    unsigned char i = 0;
+
+    do {
+        digits[i++] = value % 10 + '0';
+        value /= 10;
+    } while (value);
+    while (i) TimerA_UART_tx(digits[--i]);
+}
+
+#pragma vector = ADC10_VECTOR  // One sample
+__interrupt void ADC10_ISR(void) {
+    jitterStamp();
+    temperature = ADC10MEM;
+    if (++served == JITTER_SAMPLES) {
+        ADC10CTL0 &= ~(ENC + ADC10IE);
+        TA0CTL = 0;
+        TA0CCTL1 = 0;
+        runDone = 1;
+    }
+    __bic_SR_register_on_exit(LPM0_bits); // Wake up main loop for jitterUpdate()
+}
+
+#if LOAD_CYCLES
+#pragma vector = WDT_VECTOR     // CPU load
+__interrupt void WDT_ISR(void) {
+    __delay_cycles(LOAD_CYCLES);
+}
+#endif
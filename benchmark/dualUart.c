@@ -0,0 +1,201 @@
+/*
+ * dualUart.c
+ *
+ * Both soft UART ports full duplex at the same time and the combined throughput they sustain.
+ * The PC streams bytes 0x00, 0x01, .. 0xFF, 0x00, .. back to back with 2 stop bits (a TX frame of the driver
+ * takes 11 bit times) to RXD of uart0 (P1.2) and of uart1 (P2.1), each port checks its sequence. The main loop
+ * polls both ports and starts the next byte of its own 00 .. FF sequence as soon as a transmitter is free, so
+ * four bit ISR streams run interleaved at the full rate.
+ * The Timer1_A vectors have the higher priority: bits of uart1 delay those of uart0, never the other way round.
+ * 1. The driver is built with UART_STATS, worst/mean/late are the arming times of uartStress.c per direction
+ * 2. The run lasts DUAL_SECONDS from the first byte, timed by the WDT interval (SMCLK / 8192);
+ *    bit_s = data bits received and sent on both ports per second, at most 4 * 8 / 11 * baud
+ * 3. limit_baud = SMCLK_HZ / worst arming time of all four directions: the highest rate at which both ports
+ *    would still have armed every bit in time. Rebuild with UART_BAUD at the next standard rate below it and
+ *    check that errors and the late counts stay 0, bit_s of that run is the combined limit.
+ * "port,baud,rx_bytes,errors,tx_bytes,tx_worst,tx_mean,tx_late,rx_worst,rx_mean,rx_late" then
+ * "elapsed_ms,bit_s,limit_baud", times in cycles, "#" lines are comments. The report goes out on uart0 after
+ * the run, stream for at least DUAL_SECONDS, e.g. host/examples/dualUart.txt in the host model.
+ * Both streams of the model start together, all four bit grids coincide: the worst case of a real link.
+ * Host model, both grids aligned: error-free up to 4800 baud at 1 MHz, 57600 at 8 MHz, 115200 at 16 MHz
+ * (bit_s 13773, 163825, 327635). The model counts register accesses only, confirm the limit on the board.
+ * Build with ../driver/system.c ../driver/uart.c and -DUART_RX -DUART_STATS -DUART1, e.g. -DCLOCK_MHZ=16
+ * -DUART_BAUD=115200 (UART1_BAUD is UART_BAUD unless given).
+ */
+
+#include "msp430.h"
+#include "../driver/system.h"
+#include "../driver/uart.h"
+
+#if !defined(UART_RX) || !defined(UART_STATS) || !defined(UART1)
+#error "dualUart.c needs both ports, the receive path and the bit statistics, build with -DUART_RX -DUART_STATS -DUART1"
+#endif
+
+#define DUAL_SECONDS 2
+#define WDT_DIVIDER 8192UL      // SMCLK cycles per WDT interval
+#define DUAL_TICKS (DUAL_SECONDS * SMCLK_HZ / WDT_DIVIDER)
+
+struct link {
+    struct uart *u;
+    unsigned long baud;
+    unsigned char expected, started, next;
+    unsigned int received, errors, sent;
+    struct uartStats tx, rx;
+};
+
+struct link links[2];
+volatile unsigned int ticks = 0;
+volatile unsigned char runDone = 0;
+
+void configPorts(void);
+void receive(struct link *l);
+void report(unsigned long elapsed);
+void printLong(unsigned long value);
+
+void main(void) {
+    struct link *l;
+    unsigned char i;
+
+    configWDT();
+    configClocks();
+    configPorts();
+    TimerA_UART_init();
+    TimerA1_UART_init();
+    links[0].u = &uart0;
+    links[0].baud = UART_BAUD;
+    links[1].u = &uart1;
+    links[1].baud = UART1_BAUD;
+    __enable_interrupt();
+
+    TimerA_UART_print("# dualUart ");
+    printLong(UART_BAUD);
+    TimerA_UART_print(" / ");
+    printLong(UART1_BAUD);
+    TimerA_UART_print(" baud ");
+    TimerA_UART_printNum(CLOCK_MHZ);
+    TimerA_UART_print(" MHz, stream 00 01 .. FF to both RXD\r\n");
+
+    __disable_interrupt();
+    while (!uart0.rxReady && !uart1.rxReady) {
+        __bis_SR_register(LPM0_bits + GIE); // First byte on either port starts the clock
+        __disable_interrupt();
+    }
+    __enable_interrupt();
+    uartStatsClear(&uart0);
+    uartStatsClear(&uart1);
+    WDTCTL = WDT_MDLY_8;        // Interval timer, SMCLK / 8192
+    IE1 |= WDTIE;
+
+    while (!runDone) {          // Polling, the TX ISR does not wake the CPU
+        for (i = 0; i < 2; i++) {
+            l = &links[i];
+            if (l->u->rxReady) {
+                receive(l);
+            }
+            if (uartTxIdle(l->u)) {
+                uartTx(l->u, l->next++);
+                l->sent++;
+            }
+        }
+    }
+
+    __disable_interrupt();
+    links[0].tx = uart0.txStats;
+    links[0].rx = uart0.rxStats;
+    links[1].tx = uart1.txStats;
+    links[1].rx = uart1.rxStats;
+    __enable_interrupt();
+    while (!uartTxIdle(&uart0));
+    report(DUAL_TICKS);
+
+    for (;;) {
+        __bis_SR_register(LPM0_bits + GIE); // Reset to run again
+    }
+}
+
+void configPorts(void) {
+    P1OUT = 0x00;               // Initialize all GPIO
+    P1DIR = 0xFF & ~UART_RXD;   // Set pins to output
+    P2OUT = 0x00;
+    P2DIR = 0xFF & ~UART1_RXD;
+}
+
+// Check the received byte against the stream
+void receive(struct link *l) {
+    unsigned char byte = l->u->rxBuffer;
+
+    l->u->rxReady = 0;
+    if (l->started && byte != l->expected) {
+        l->errors++;            // Corrupted or lost byte, follow the stream again
+    }
+    l->started = 1;
+    l->expected = byte + 1;
+    l->received++;
+}
+
+void report(unsigned long elapsed) {
+    struct link *l;
+    unsigned long ms, bits;
+    unsigned int worst = 0;
+    unsigned char i;
+
+    TimerA_UART_print("port,baud,rx_bytes,errors,tx_bytes,tx_worst,tx_mean,tx_late,rx_worst,rx_mean,rx_late\r\n");
+    bits = 0;
+    for (i = 0; i < 2; i++) {
+        l = &links[i];
+        if (l->tx.worst > worst) worst = l->tx.worst;
+        if (l->rx.worst > worst) worst = l->rx.worst;
+        bits += 8UL * (l->received + l->sent);
+        TimerA_UART_printNum(i);
+        TimerA_UART_tx(',');
+        printLong(l->baud);
+        TimerA_UART_tx(',');
+        TimerA_UART_printNum(l->received);
+        TimerA_UART_tx(',');
+        TimerA_UART_printNum(l->errors);
+        TimerA_UART_tx(',');
+        TimerA_UART_printNum(l->sent);
+        TimerA_UART_tx(',');
+        TimerA_UART_printNum(l->tx.worst);
+        TimerA_UART_tx(',');
+        TimerA_UART_printNum(l->tx.bits ? (unsigned int)(l->tx.sum / l->tx.bits) : 0);
+        TimerA_UART_tx(',');
+        TimerA_UART_printNum(l->tx.late);
+        TimerA_UART_tx(',');
+        TimerA_UART_printNum(l->rx.worst);
+        TimerA_UART_tx(',');
+        TimerA_UART_printNum(l->rx.bits ? (unsigned int)(l->rx.sum / l->rx.bits) : 0);
+        TimerA_UART_tx(',');
+        TimerA_UART_printNum(l->rx.late);
+        TimerA_UART_print("\r\n");
+    }
+    ms = elapsed * WDT_DIVIDER / (SMCLK_HZ / 1000);
+    TimerA_UART_print("elapsed_ms,bit_s,limit_baud\r\n");
+    printLong(ms);
+    TimerA_UART_tx(',');
+    printLong(ms ? bits * 1000 / ms : 0);
+    TimerA_UART_tx(',');
+    printLong(worst ? SMCLK_HZ / worst : 0);
+    TimerA_UART_print("\r\n# done\r\n");
+}
+
+// TimerA_UART_printNum for values above 65535
+void printLong(unsigned long value) {
+    char digits[10];
+    unsigned char i = 0;
+
+    do {
+        digits[i++] = value % 10 + '0';
+        value /= 10;
+    } while (value);
+    while (i) TimerA_UART_tx(digits[--i]);
+}
+
+#pragma vector = WDT_VECTOR     // Run time
+__interrupt void WDT_ISR(void) {
+    if (++ticks == DUAL_TICKS) {
+        WDTCTL = WDTPW + WDTHOLD; // Stop the run
+        runDone = 1;
+        __bic_SR_register_on_exit(LPM0_bits);
+    }
+}
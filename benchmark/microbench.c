@@ -0,0 +1,242 @@
+/*
+ * microbench.c
+ *
+ * Cycle counts of the routines the programs are built from, printed as a CSV table over the soft UART.
+ * Timer1_A counts SMCLK in continuous mode. SMCLK is the undivided DCO like MCLK (Timer_A cannot select MCLK
+ * itself), so one timer tick is one CPU cycle at every CLOCK_MHZ.
+ * 1. measure() reads TA1R, calls the kernel and reads TA1R again; the same call of an empty kernel is the
+ *    overhead and is subtracted, the numbers are the cycles of the kernel body alone
+ * 2. Every kernel runs BENCH_REPEAT times (ISR kernels a whole number of frames) with changing inputs,
+ *    min/mean/max show how much a routine depends on its data
+ * 3. The bit ISRs are entered by setting CCIFG by software with Timer0_A stopped and TXD disconnected,
+ *    their numbers include the 6 cycles of the interrupt entry and the 5 of RETI
+ * 4. ADC start to ISR is timed from the TA1R read before ADC10SC to the one in the ISR, nothing subtracted;
+ *    the conversion runs from ADC10OSC (~5 MHz), so it is the only kernel whose cycles scale with CLOCK_MHZ
+ * 5. The results stay in RAM until the last kernel is done, no UART bit ISR fires while a kernel is timed
+ * Kernels: tx_setup (TimerA_UART_tx with the transmitter idle), tx_bit_isr, rx_bit_isr, adc_to_isr,
+ * div16 (unsigned int / unsigned int), div32 (unsigned long / unsigned int), mod10_2digit (the tens/units
+ * output of softwareUART_application4.c), print_digits (the % 10 loop of TimerA_UART_printNum without TX).
+ * These four are pure computation and mean something on the target only: the host model (host/README.md) charges
+ * nothing between register accesses, there they print 0. The other rows are register bound and comparable.
+ * Build once per clock, e.g. with ../driver/system.c ../driver/uart.c and -DUART_RX -DCLOCK_MHZ=16,
+ * and compare the tables: "kernel,mhz,n,min,mean,max" in cycles, "#" lines are comments.
+ */
+
+#include "msp430.h"
+#include "../driver/system.h"
+#include "../driver/uart.h"
+
+#ifndef UART_RX
+#error "microbench.c times the RX bit ISR, build with -DUART_RX"
+#endif
+
+#define BENCH_REPEAT 32
+#define TX_FRAME_ISRS 11        // 10 bits + the one that stops the transmitter
+#define RX_FRAME_ISRS 9         // Start bit + 8 data bits
+#define KERNELS 8
+
+struct result {
+    const char *name;
+    unsigned int min, max;
+    unsigned long sum;
+    unsigned char n;
+};
+
+volatile unsigned int benchIndex;
+volatile unsigned int benchA, benchB, benchQuotient;
+volatile unsigned long benchLong, benchLongQuotient;
+volatile unsigned char benchTens, benchUnits;
+volatile unsigned int adcStamp;
+volatile unsigned char adcDone;
+char benchDigits[5];
+unsigned int overhead;
+struct result results[KERNELS];
+unsigned char resultCount = 0;
+
+void configP1(void);
+void configTimebase(void);
+unsigned int measure(void (*kernel)(void));
+void sample(struct result *r, unsigned int cycles);
+void run(const char *name, void (*kernel)(void), unsigned char n);
+void report(struct result *r);
+void kernelEmpty(void);
+void kernelTxSetup(void);
+void kernelTxBitIsr(void);
+void kernelRxBitIsr(void);
+void kernelDiv16(void);
+void kernelDiv32(void);
+void kernelMod10(void);
+void kernelPrintDigits(void);
+void benchAdc(void);
+
+void main(void) {
+    unsigned char i;
+    unsigned int least = 0xFFFF, cycles;
+
+    configWDT();
+    configClocks();
+    configP1();
+    TimerA_UART_init();
+    configTimebase();
+    __enable_interrupt();
+
+    for (i = 0; i < BENCH_REPEAT; i++) {   // Call and two TA1R reads, the smallest is the overhead
+        cycles = measure(kernelEmpty);
+        if (cycles < least) {
+            least = cycles;
+        }
+    }
+    overhead = least;
+
+    P1OUT |= UART_TXD;          // TXD idle '1' as GPIO, the bytes of the kernels do not reach the PC
+    P1SEL &= ~UART_TXD;
+    run("tx_setup", kernelTxSetup, BENCH_REPEAT);
+    while (TA0CCTL0 & CCIE);    // Last byte out before the timer stops
+    TA0CTL &= ~MC_3;            // Bit ISRs by software only
+    run("tx_bit_isr", kernelTxBitIsr, 3 * TX_FRAME_ISRS);
+    run("rx_bit_isr", kernelRxBitIsr, 4 * RX_FRAME_ISRS);
+    uart0.rxReady = 0;
+    TimerA_UART_init();         // Transmitter and receiver back to idle, TXD connected again
+
+    benchAdc();
+    run("div16", kernelDiv16, BENCH_REPEAT);
+    run("div32", kernelDiv32, BENCH_REPEAT);
+    run("mod10_2digit", kernelMod10, BENCH_REPEAT);
+    run("print_digits", kernelPrintDigits, BENCH_REPEAT);
+
+    TimerA_UART_print("# microbench MCLK=SMCLK=TA1 clock, overhead ");
+    TimerA_UART_printNum(overhead);
+    TimerA_UART_print(" cycles subtracted\r\nkernel,mhz,n,min,mean,max\r\n");
+    for (i = 0; i < resultCount; i++) {
+        report(&results[i]);
+    }
+    TimerA_UART_print("# done\r\n");
+
+    for (;;) {
+        __bis_SR_register(LPM0_bits + GIE); // Reset to run again
+    }
+}
+
+void configP1(void) {
+    P1OUT = 0x00;               // Initialize all GPIO
+    P1DIR = 0xFF & ~UART_RXD;   // Set pins to output
+}
+
+void configTimebase(void) {
+    BCSCTL2 &= ~DIVS_3;         // SMCLK = DCO = MCLK
+    TA1CTL = TASSEL_2 + MC_2 + TACLR; // SMCLK, continuous mode
+}
+
+unsigned int measure(void (*kernel)(void)) {
+    unsigned int start, stop;
+
+    start = TA1R;
+    kernel();
+    stop = TA1R;
+    return stop - start;
+}
+
+void sample(struct result *r, unsigned int cycles) {
+    if (cycles < r->min) r->min = cycles;
+    if (cycles > r->max) r->max = cycles;
+    r->sum += cycles;
+    r->n++;
+}
+
+void run(const char *name, void (*kernel)(void), unsigned char n) {
+    struct result *r = &results[resultCount++];
+
+    r->name = name;
+    r->min = 0xFFFF;
+    for (benchIndex = 0; benchIndex < n; benchIndex++) {
+        if (kernel == kernelTxSetup) {
+            while (TA0CCTL0 & CCIE); // Previous byte out, the kernel finds the transmitter idle
+        }
+        sample(r, measure(kernel) - overhead);
+    }
+}
+
+void report(struct result *r) {
+    TimerA_UART_print((char *)r->name);
+    TimerA_UART_tx(',');
+    TimerA_UART_printNum(CLOCK_MHZ);
+    TimerA_UART_tx(',');
+    TimerA_UART_printNum(r->n);
+    TimerA_UART_tx(',');
+    TimerA_UART_printNum(r->min);
+    TimerA_UART_tx(',');
+    TimerA_UART_printNum((unsigned int)((r->sum + r->n / 2) / r->n));
+    TimerA_UART_tx(',');
+    TimerA_UART_printNum(r->max);
+    TimerA_UART_print("\r\n");
+}
+
+void kernelEmpty(void) {
+}
+
+void kernelTxSetup(void) {
+    TimerA_UART_tx(' ');
+}
+
+void kernelTxBitIsr(void) {
+    TA0CCTL0 |= CCIE + CCIFG;   // The last ISR of a frame clears CCIE
+}
+
+void kernelRxBitIsr(void) {
+    TA0CCTL1 |= CCIE + CCIFG;   // Start bit with CAP set, data bits in compare mode
+}
+
+void kernelDiv16(void) {
+    benchA = 0xFFFF - benchIndex * 2039;
+    benchB = benchIndex * 7 + 3;
+    benchQuotient = benchA / benchB;
+}
+
+void kernelDiv32(void) {
+    benchLong = 0xFFFFFFFFUL - benchIndex * 123456789UL;
+    benchB = benchIndex * 7 + 3;
+    benchLongQuotient = benchLong / benchB;
+}
+
+void kernelMod10(void) {
+    benchA = benchIndex * 3;    // Duty cycle 0..99 %
+    benchTens = (benchA / 10) + '0';
+    benchUnits = (benchA % 10) + '0';
+}
+
+void kernelPrintDigits(void) {
+    unsigned int value = 65535 - benchIndex * 2047;
+    unsigned char i = 0;
+
+    do {
+        benchDigits[i++] = value % 10 + '0';
+        value /= 10;
+    } while (value);
+}
+
+// Start of conversion to ADC10 ISR entry, TA1R read in the ISR
+void benchAdc(void) {
+    struct result *r = &results[resultCount++];
+    unsigned int start;
+    unsigned char i;
+
+    r->name = "adc_to_isr";
+    r->min = 0xFFFF;
+    ADC10CTL1 = INCH_10 + ADC10DIV_3; // Temp Sensor ADC10CLK/4
+    ADC10CTL0 = SREF_1 + ADC10SHT_3 + REFON + ADC10ON + ADC10IE;
+    __delay_cycles(CLOCK_MHZ * 30);   // Reference settling, 30 us
+    for (i = 0; i < BENCH_REPEAT; i++) {
+        adcDone = 0;
+        start = TA1R;
+        ADC10CTL0 |= ENC + ADC10SC;
+        while (!adcDone);
+        sample(r, adcStamp - start);
+    }
+    ADC10CTL0 &= ~(ENC + ADC10IE);
+}
+
+#pragma vector = ADC10_VECTOR
+__interrupt void ADC10_ISR(void) {
+    adcStamp = TA1R;
+    adcDone = 1;
+}
@@ -0,0 +1,274 @@
+/*
+ * uartStress.c
+ *
+ * Soft UART bit timing and byte errors under interrupt load, one table row per load level.
+ * The PC streams bytes 0x00, 0x01, .. 0xFF, 0x00, .. back to back to RXD with 2 stop bits (a TX frame of the
+ * driver takes 11 bit times); the board checks the sequence and echoes every byte the transmitter is free for,
+ * so TX and RX bit ISRs run interleaved at the full rate.
+ * Timer1_A (SMCLK, continuous) injects the load: CCR1 starts an ADC10 conversion, CCR2 sets P1IFG of LOAD_PIN
+ * by software, both at the rates of loadLevels[]. The ADC10 and PORT1 ISRs spend LOAD_WORK cycles like a real
+ * handler. In the G2553 vector order TIMER1_A0/A1 outrank TIMER0_A0/A1 (the UART), which outrank ADC10 and PORT1:
+ * the short injection ISR wins over a pending UART bit, the long load ISRs lose to it when both are pending but
+ * are not preempted once running (no nesting), so a LOAD_WORK burst delays every UART bit that falls into it.
+ * 1. The driver is built with UART_STATS: per bit, the cycles from the compare (or start bit capture) to the
+ *    next compare armed. The output unit and the SCCI latch act exactly at the compare, so this is the timing
+ *    budget of every bit edge; an edge only leaves the ideal grid when it is armed late (">= 1 bit", it then
+ *    slips a whole timer period and the byte is lost)
+ * 2. Every LEVEL_SECONDS the statistics, the received bytes and sequence errors are stored and the next level
+ *    starts, after the last one the table is printed
+ * 3. limit_baud = SMCLK_HZ / worst arming time of both directions: the highest rate at which every bit of this
+ *    level would still have been armed in time. Rebuild with UART_BAUD at the next standard rate below it
+ *    and check that errors and the late counts stay 0.
+ * "level,adc_hz,gpio_hz,adc_isr,gpio_isr,bytes,errors,tx_worst,tx_mean,tx_late,rx_worst,rx_mean,rx_late,limit_baud"
+ * times in cycles, "#" lines are comments. The first received byte starts level 0, stream for at least
+ * LEVELS * LEVEL_SECONDS, e.g. host/examples/uartStress.txt in the host model.
+ * Build with ../driver/system.c ../driver/uart.c ../driver/adc.c and -DUART_RX -DUART_STATS,
+ * e.g. -DCLOCK_MHZ=8 -DUART_BAUD=38400.
+ */
+
+#include "msp430.h"
+#include "../driver/system.h"
+#include "../driver/uart.h"
+#include "../driver/adc.h"
+
+#if !defined(UART_RX) || !defined(UART_STATS)
+#error "uartStress.c needs the receive path and the bit statistics, build with -DUART_RX -DUART_STATS"
+#endif
+
+#define LOAD_PIN BIT4           // P1.4, interrupt flag set by software
+#define LOAD_WORK 40            // Cycles spent by each load ISR
+#define LEVEL_SECONDS 2
+#define LEVEL_OVERFLOWS (LEVEL_SECONDS * SMCLK_HZ / 65536UL) // Timer1_A periods per level
+#define LEVELS 5
+
+// Load rates in Hz, 0 = off; SMCLK_HZ / rate must fit into 16 bits (>= 245 Hz at 16 MHz)
+const struct load {
+    unsigned int adcHz, gpioHz;
+} loadLevels[LEVELS] = {
+    {0, 0},
+    {250, 250},
+    {1000, 1000},
+    {2500, 2500},
+    {5000, 5000}
+};
+
+struct result {
+    unsigned int adcIsrs, gpioIsrs;
+    unsigned int bytes, errors;
+    struct uartStats tx, rx;
+};
+
+struct result results[LEVELS];
+volatile unsigned char levelDue = 0;
+volatile unsigned int adcIsrs, gpioIsrs;
+volatile unsigned int adcValue;
+unsigned int adcInterval, gpioInterval;
+
+void configP1(void);
+void startLevel(unsigned char level);
+void endLevel(unsigned char level, unsigned int bytes, unsigned int errors);
+void report(void);
+void printLong(unsigned long value);
+
+void main(void) {
+    unsigned char level = 0, byte, expected;
+    unsigned int bytes = 0, errors = 0;
+
+    configWDT();
+    configClocks();
+    configP1();
+    configADC(INCH_10);
+    ADC10CTL0 |= ADC10IE;
+    TimerA_UART_init();
+    __enable_interrupt();
+
+    TimerA_UART_print("# uartStress ");
+    printLong(UART_BAUD);
+    TimerA_UART_print(" baud ");
+    TimerA_UART_printNum(CLOCK_MHZ);
+    TimerA_UART_print(" MHz, stream 00 01 .. FF to RXD\r\n");
+
+    __disable_interrupt();
+    while (!uart0.rxReady) {
+        __bis_SR_register(LPM0_bits + GIE); // First byte of the stream
+        __disable_interrupt();
+    }
+    __enable_interrupt();
+    expected = uart0.rxBuffer + 1;
+    uart0.rxReady = 0;
+    startLevel(0);
+
+    for (;;) {
+        __disable_interrupt();
+        while (!uart0.rxReady && !levelDue) {
+            __bis_SR_register(LPM0_bits + GIE); // Wait for a byte or the end of the level
+            __disable_interrupt();
+        }
+        __enable_interrupt();
+
+        if (uart0.rxReady) {
+            byte = uart0.rxBuffer;
+            uart0.rxReady = 0;
+            bytes++;
+            if (byte != expected) {
+                errors++;       // Corrupted or lost byte, follow the stream again
+            }
+            expected = byte + 1;
+            if (!(TA0CCTL0 & CCIE)) {
+                TimerA_UART_tx(byte); // Echo without waiting, the transmitter stays busy
+            }
+        }
+        if (levelDue) {
+            levelDue = 0;
+            endLevel(level, bytes, errors);
+            bytes = errors = 0;
+            if (++level == LEVELS) {
+                break;
+            }
+            startLevel(level);
+        }
+    }
+
+    TA1CTL = TACLR;             // Load off, the table goes out undisturbed
+    TA1CCTL1 = TA1CCTL2 = 0;
+    report();
+
+    for (;;) {
+        __bis_SR_register(LPM0_bits + GIE); // Reset to run again
+    }
+}
+
+void configP1(void) {
+    P1OUT = 0x00;               // Initialize all GPIO
+    P1DIR = 0xFF & ~UART_RXD;   // Set pins to output
+    P1IFG = 0;
+    P1IE = LOAD_PIN;
+}
+
+// Load rates of the level, Timer1_A SMCLK in continuous mode, TAIFG counts the level time
+void startLevel(unsigned char level) {
+    const struct load *l = &loadLevels[level];
+
+    TA1CTL = TACLR;
+    adcIsrs = gpioIsrs = 0;
+    TimerA_UART_statsClear();
+    if (l->adcHz) {
+        adcInterval = SMCLK_HZ / l->adcHz;
+        TA1CCR1 = adcInterval;
+        TA1CCTL1 = CCIE;
+    } else {
+        TA1CCTL1 = 0;
+    }
+    if (l->gpioHz) {
+        gpioInterval = SMCLK_HZ / l->gpioHz;
+        TA1CCR2 = gpioInterval;
+        TA1CCTL2 = CCIE;
+    } else {
+        TA1CCTL2 = 0;
+    }
+    TA1CTL = TASSEL_2 + MC_2 + TACLR + TAIE; // SMCLK, continuous mode
+}
+
+void endLevel(unsigned char level, unsigned int bytes, unsigned int errors) {
+    struct result *r = &results[level];
+
+    __disable_interrupt();
+    r->adcIsrs = adcIsrs;
+    r->gpioIsrs = gpioIsrs;
+    r->tx = uart0.txStats;
+    r->rx = uart0.rxStats;
+    __enable_interrupt();
+    r->bytes = bytes;
+    r->errors = errors;
+}
+
+void report(void) {
+    struct result *r;
+    unsigned int worst;
+    unsigned char i;
+
+    TimerA_UART_print("level,adc_hz,gpio_hz,adc_isr,gpio_isr,bytes,errors,"
+                      "tx_worst,tx_mean,tx_late,rx_worst,rx_mean,rx_late,limit_baud\r\n");
+    for (i = 0; i < LEVELS; i++) {
+        r = &results[i];
+        worst = r->tx.worst > r->rx.worst ? r->tx.worst : r->rx.worst;
+        TimerA_UART_printNum(i);
+        TimerA_UART_tx(',');
+        TimerA_UART_printNum(loadLevels[i].adcHz);
+        TimerA_UART_tx(',');
+        TimerA_UART_printNum(loadLevels[i].gpioHz);
+        TimerA_UART_tx(',');
+        TimerA_UART_printNum(r->adcIsrs);
+        TimerA_UART_tx(',');
+        TimerA_UART_printNum(r->gpioIsrs);
+        TimerA_UART_tx(',');
+        TimerA_UART_printNum(r->bytes);
+        TimerA_UART_tx(',');
+        TimerA_UART_printNum(r->errors);
+        TimerA_UART_tx(',');
+        TimerA_UART_printNum(r->tx.worst);
+        TimerA_UART_tx(',');
+        TimerA_UART_printNum(r->tx.bits ? (unsigned int)(r->tx.sum / r->tx.bits) : 0);
+        TimerA_UART_tx(',');
+        TimerA_UART_printNum(r->tx.late);
+        TimerA_UART_tx(',');
+        TimerA_UART_printNum(r->rx.worst);
+        TimerA_UART_tx(',');
+        TimerA_UART_printNum(r->rx.bits ? (unsigned int)(r->rx.sum / r->rx.bits) : 0);
+        TimerA_UART_tx(',');
+        TimerA_UART_printNum(r->rx.late);
+        TimerA_UART_tx(',');
+        printLong(worst ? SMCLK_HZ / worst : 0);
+        TimerA_UART_print("\r\n");
+    }
+    TimerA_UART_print("# done\r\n");
+}
+
+// TimerA_UART_printNum for rates above 65535
+void printLong(unsigned long value) {
+    char digits[10];
+    unsigned char i = 0;
+
+    do {
+        digits[i++] = value % 10 + '0';
+        value /= 10;
+    } while (value);
+    while (i) TimerA_UART_tx(digits[--i]);
+}
+
+#pragma vector = TIMER1_A1_VECTOR  // Load injection and level time
+__interrupt void Timer1_A1_ISR(void) {
+    static unsigned int overflows = 0;
+
+    switch (__even_in_range(TA1IV, TA1IV_TAIFG)) {
+        case TA1IV_TACCR1:
+            TA1CCR1 += adcInterval;
+            ADC10CTL0 |= ENC + ADC10SC; // Ignored while the previous conversion runs
+            break;
+        case TA1IV_TACCR2:
+            TA1CCR2 += gpioInterval;
+            P1IFG |= LOAD_PIN;  // Same request as an edge on the pin
+            break;
+        case TA1IV_TAIFG:
+            if (++overflows >= LEVEL_OVERFLOWS) {
+                overflows = 0;
+                levelDue = 1;
+                __bic_SR_register_on_exit(LPM0_bits);
+            }
+            break;
+    }
+}
+
+#pragma vector = ADC10_VECTOR
+__interrupt void ADC10_ISR(void) {
+    adcValue = ADC10MEM;
+    adcIsrs++;
+    __delay_cycles(LOAD_WORK);
+}
+
+#pragma vector = PORT1_VECTOR
+__interrupt void Port_1(void) {
+    P1IFG &= ~LOAD_PIN;
+    gpioIsrs++;
+    __delay_cycles(LOAD_WORK);
+}
@@ -0,0 +1,14 @@
+#include "msp430.h"
+#include "adc.h"
+
+void configADC(unsigned int channel) {
+    ADC10CTL0 &= ~ENC;          // INCH can only change with ENC cleared
+    ADC10CTL1 = channel + ADC10DIV_3; // ADC10CLK/4
+    ADC10CTL0 = SREF_1 + ADC10SHT_3 + REFON + ADC10ON; // Internal ref on, ADC on
+}
+
+unsigned int readADC(void) {
+    ADC10CTL0 |= ENC + ADC10SC; // Sampling and conversion start
+    while (ADC10CTL1 & ADC10BUSY); // Wait until conversion is complete
+    return ADC10MEM;
+}
@@ -0,0 +1,14 @@
+/*
+ * adc.h
+ *
+ * ADC10 single conversions against the internal 1.5 V reference.
+ * The reference needs 30 us to settle after configADC(), the first readADC() must come later.
+ */
+
+#ifndef DRIVER_ADC_H
+#define DRIVER_ADC_H
+
+void configADC(unsigned int channel);   // INCH_x, e.g. INCH_10 temperature sensor, INCH_11 Vcc/2
+unsigned int readADC(void);             // Start one conversion and wait for the result
+
+#endif
@@ -0,0 +1,227 @@
+#include "msp430.h"
+#include "adcjitter.h"
+
+static struct {
+    unsigned long cycles;       // Since the previous service
+    unsigned int phase;         // Timer0_A ticks since the trigger
+} ring[JITTER_RING];
+static volatile unsigned char ringHead, ringCount, active = 0;
+static volatile unsigned int overflows, lost;
+static unsigned int periodTicks, trigger; // TA0CCR0 + 1, TA0CCR1
+static unsigned long lastStamp;
+static unsigned char stamped;
+
+// jitterUpdate() runs per sample on a CPU without multiplier: no division there but every JITTER_MEAN triggers
+#define JITTER_MEAN 16
+static unsigned long period;    // Sampling period in SMCLK cycles
+static unsigned long tickCycles; // Sampling clock tick in 1/2^tickShift SMCLK cycles
+static unsigned char tickShift; // 8, less for a period of 2^24 cycles and more: tickCycles * periodTicks < 2^32
+static unsigned long long spanCycles; // Trigger to trigger over the run
+static unsigned long spanTriggers;
+static unsigned char sinceMean;
+static unsigned long periods, late, reference, min, max;
+static long sum;                // Deviations of the service intervals from reference, the first one
+static unsigned long long squares;
+static unsigned int lastPhase, delay;
+
+// Timer0_A runs from ACLK, asynchronous to MCLK: read until two values agree
+static unsigned int jitterTicks(void) {
+    unsigned int ticks;
+
+    do {
+        ticks = TA0R;
+    } while (ticks != TA0R);
+    return ticks;
+}
+
+// SMCLK cycles from Timer1_A, with interrupts disabled
+static unsigned long jitterNow(void) {
+    unsigned int high = overflows, low = TA1R;
+
+    if ((TA1CTL & TAIFG) && low < 0x8000) {
+        high++;                 // Overflow not served yet
+    }
+    return (unsigned long)high << 16 | low;
+}
+
+// tickCycles from period, the fraction shrinks so that the products of jitterUpdate() stay 32 bits
+static void jitterScale(void) {
+    for (tickShift = 8; tickShift && (period >> (32 - tickShift)); tickShift--);
+    tickCycles = (period << tickShift) / periodTicks;
+}
+
+// SMCLK cycles with interrupts enabled
+static unsigned long jitterTime(void) {
+    unsigned int high, low;
+
+    do {
+        high = overflows;
+        low = TA1R;
+    } while (high != overflows);
+    return (unsigned long)high << 16 | low;
+}
+
+void jitterStart(void) {
+    unsigned int edge;
+    unsigned long start;
+
+    active = 0;
+    periodTicks = TA0CCR0 + 1;
+    trigger = TA0CCR1;
+    overflows = lost = 0;
+    TA1CTL = TASSEL_2 + MC_2 + TACLR + TAIE; // SMCLK, continuous mode
+    edge = jitterTicks();
+    while (jitterTicks() == edge); // Next tick edge
+    edge = jitterTicks();
+    start = jitterTime();
+    while (jitterTicks() == edge);
+    while (jitterTicks() != edge); // Same tick one period later
+    period = jitterTime() - start;
+    jitterScale();
+    spanCycles = period;        // The timed period is the first of the mean
+    spanTriggers = 1;
+    sinceMean = 0;
+
+    ringHead = ringCount = 0;
+    stamped = 0;
+    periods = late = sum = squares = max = 0;
+    min = ~0UL;
+    delay = 0;
+    active = 1;
+}
+
+void jitterStamp(void) {
+    unsigned long now;
+    unsigned int ticks;
+    unsigned char i;
+
+    if (!active) {
+        return;
+    }
+    now = jitterNow();
+    ticks = jitterTicks();
+    if (ringCount == JITTER_RING) {
+        lost++;                 // The next entry spans two services, not counted
+        stamped = 0;
+        return;
+    }
+    i = (ringHead + ringCount) & (JITTER_RING - 1);
+    ring[i].cycles = stamped ? now - lastStamp : 0;
+    ring[i].phase = ticks >= trigger ? ticks - trigger : ticks + periodTicks - trigger;
+    ringCount++;
+    stamped = 1;
+    lastStamp = now;
+}
+
+void jitterUpdate(void) {
+    unsigned short state;
+    unsigned long cycles, limit;
+    unsigned int phase, n;
+    long e, triggers;
+
+    while (ringCount) {
+        cycles = ring[ringHead].cycles;
+        phase = ring[ringHead].phase;
+        state = __get_SR_register() & GIE;
+        __disable_interrupt();
+        ringHead = (ringHead + 1) & (JITTER_RING - 1);
+        ringCount--;
+        __bis_SR_register(state);
+        if (phase > delay) {
+            delay = phase;
+        }
+        if (!cycles) {          // First service or the first after a full ring
+            lastPhase = phase;
+            continue;
+        }
+        if (lastPhase >= phase) { // Trigger to trigger, the phase difference is below periodTicks
+            triggers = (long)(cycles + (tickCycles * (lastPhase - phase) >> tickShift));
+        } else {
+            triggers = (long)(cycles - (tickCycles * (phase - lastPhase) >> tickShift));
+        }
+        lastPhase = phase;
+        if (triggers <= 0) {
+            continue;           // Not possible unless the sampling timer was changed
+        }
+        for (n = 0, limit = period - period / 2; (unsigned long)triggers >= limit; n++) {
+            limit += period;    // Periods in the interval, rounded
+        }
+        spanCycles += triggers;
+        spanTriggers += n;
+        sinceMean += n;
+        if (sinceMean >= JITTER_MEAN) { // Mean so far, a drifting VLO moves it
+            sinceMean = 0;
+            period = (spanCycles + spanTriggers / 2) / spanTriggers;
+            jitterScale();
+        }
+        if (n == 0) {           // The phase wrapped the time before, that read was counted one period late
+            if (late) late--;
+            continue;
+        }
+        if (n != 1) {
+            late += n - 1;      // The results between were overwritten
+            continue;
+        }
+        if (!periods) {
+            reference = cycles;
+        }
+        e = (long)(cycles - reference);
+        sum += e;
+        if (e > -0x8000L && e < 0x8000L) {
+            squares += (unsigned long)((long)(int)e * (int)e); // 16 x 16 bits, the usual case
+        } else {
+            squares += (unsigned long long)((long long)e * e);
+        }
+        periods++;
+        if (cycles < min) min = cycles;
+        if (cycles > max) max = cycles;
+    }
+}
+
+// Integer square root, bit by bit
+static unsigned long jitterSqrt(unsigned long long x) {
+    unsigned long long root = 0, bit = 1ULL << 62;
+
+    while (bit > x) bit >>= 2;
+    while (bit) {
+        if (x >= root + bit) {
+            x -= root + bit;
+            root = (root >> 1) + bit;
+        } else {
+            root >>= 1;
+        }
+        bit >>= 2;
+    }
+    return (unsigned long)root;
+}
+
+void jitterStop(struct jitterStats *s) {
+    long long mean;
+
+    jitterUpdate();
+    active = 0;
+    TA1CTL = 0;
+    jitterUpdate();             // A stamp taken meanwhile
+    period = (spanCycles + spanTriggers / 2) / spanTriggers;
+    s->periods = periods;
+    s->late = late;
+    s->delay = delay;
+    s->lost = lost;
+    s->min = periods ? min : 0;
+    s->max = max;
+    s->mean = period;
+    s->stddev = 0;
+    if (periods) {
+        mean = sum / (long)periods; // Around the reference
+        s->stddev = jitterSqrt(squares / periods - (unsigned long long)(mean * mean));
+    }
+}
+
+#pragma vector = TIMER1_A1_VECTOR  // Reference overflow
+__interrupt void Timer1_A1_ISR(void) {
+    switch (__even_in_range(TA1IV, TA1IV_TAIFG)) {
+        case TA1IV_TAIFG:
+            overflows++;
+            break;
+    }
+}
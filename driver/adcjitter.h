@@ -0,0 +1,41 @@
+/*
+ * adcjitter.h
+ *
+ * Sampling-jitter instrumentation of ADC10 conversions triggered by Timer0_A OUT1 in up mode (SHS_1, OUTMOD_3 on
+ * CCR1), as in ADC/RepetitiveConversion2.c and ADC/ADC_application1.c.
+ * Timer1_A counts SMCLK continuously as the DCO reference, its overflows extend it to 32 bits. The application
+ * calls jitterStamp() first in its ADC10 ISR: the DCO time of the service and the phase of Timer0_A (ticks since
+ * the last trigger) go to a ring of JITTER_RING entries, jitterUpdate() folds them into the statistics from the
+ * main loop.
+ * Service time minus phase is the trigger of the result that was read. When two of them lie more than one
+ * sampling period apart, the results between were overwritten in ADC10MEM before the ISR ran: late reads.
+ * This holds whatever delayed the ISR, the phase comes from the sampling timer itself.
+ * mean is the sampling period from the triggers of the whole run, it follows a drifting VLO. stddev, min and max
+ * are those of the intervals between two services of consecutive results, the service delay of the CPU on top of
+ * the sampling clock: a delayed ISR makes one interval longer and the next one shorter. delay is the longest
+ * phase seen, trigger to service in sampling clock ticks.
+ * jitterStart() times one sampling period against the DCO first, Timer0_A must be running.
+ * While active the unit owns Timer1_A and TIMER1_A1_VECTOR (no UART1); SMCLK must run, so LPM0 at most.
+ */
+
+#ifndef DRIVER_ADCJITTER_H
+#define DRIVER_ADCJITTER_H
+
+#define JITTER_RING 8
+
+struct jitterStats {
+    unsigned long periods;      // Service intervals of one sampling period
+    unsigned long late;         // Results overwritten before their ISR ran
+    unsigned long mean;         // SMCLK cycles per sampling period, trigger to trigger over the run
+    unsigned long stddev;       // Of the service intervals
+    unsigned long min, max;     // Shortest and longest service interval
+    unsigned int delay;         // Longest trigger to service, sampling clock ticks
+    unsigned int lost;          // Services the full ring could not take
+};
+
+void jitterStart(void);         // Reference running, one sampling period timed, statistics cleared
+void jitterStamp(void);         // First thing in the ADC10 ISR
+void jitterUpdate(void);        // Empty the ring, from the main loop
+void jitterStop(struct jitterStats *s); // Reference off, the statistics of the run
+
+#endif
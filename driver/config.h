@@ -0,0 +1,51 @@
+/*
+ * config.h
+ *
+ * Compile-time selection for the driver units. Every unit and the application must see the same values,
+ * so set them on the compiler command line (-DCLOCK_MHZ=8 -DUART_RX) and not in one source file only.
+ *   CLOCK_MHZ  1, 8 or 16: calibrated DCO for MCLK and SMCLK (default 1)
+ *   UART_BAUD  soft UART baud rate (default 9600)
+ *   UART_RX    defined: the soft UART receives too, Timer0_A CCR1 and TIMER0_A1_VECTOR are taken
+ *   UART_STATS defined: the bit ISRs record how long after its compare the next compare is armed
+ *   UART_RING  defined: uartTx queues in a TX ring of UART_TX_SIZE bytes (default 32) and only waits when it is full,
+ *              with UART_RX the bytes arrive in an RX ring of UART_RX_SIZE (default 8) read by uartRx; powers of two
+ *   UART1      defined: second soft UART port on Timer1_A (P2.0/P2.1), TIMER1_A0/TIMER1_A1_VECTOR are taken
+ *   UART1_BAUD baud rate of the second port (default UART_BAUD)
+ *   SPI_DIV    USCI_B0 SPI clock = SMCLK / SPI_DIV (default 2)
+ *   SPIMEM_FRAM defined: the SPI memory is FRAM, written without erase
+ */
+
+#ifndef DRIVER_CONFIG_H
+#define DRIVER_CONFIG_H
+
+#ifndef CLOCK_MHZ
+#define CLOCK_MHZ 1
+#endif
+
+#if CLOCK_MHZ != 1 && CLOCK_MHZ != 8 && CLOCK_MHZ != 16
+#error "CLOCK_MHZ must be 1, 8 or 16 (calibrated DCO settings)"
+#endif
+
+#define SMCLK_HZ (CLOCK_MHZ * 1000000UL)
+
+#ifndef UART_BAUD
+#define UART_BAUD 9600
+#endif
+
+#ifndef UART1_BAUD
+#define UART1_BAUD UART_BAUD
+#endif
+
+#ifndef UART_TX_SIZE
+#define UART_TX_SIZE 32
+#endif
+
+#ifndef UART_RX_SIZE
+#define UART_RX_SIZE 8
+#endif
+
+#ifndef SPI_DIV
+#define SPI_DIV 2
+#endif
+
+#endif
@@ -0,0 +1,32 @@
+#include "msp430.h"
+#include "flash.h"
+
+void configFlash(void) {
+    FCTL2 = FWKEY + FSSEL_1 + (FLASH_DIV - 1); // MCLK / FLASH_DIV
+}
+
+void flashEraseSegment(unsigned int *segment) {
+    unsigned short state = __get_SR_register() & GIE;
+
+    __disable_interrupt();
+    FCTL3 = FWKEY;              // Clear LOCK
+    FCTL1 = FWKEY + ERASE;      // Segment erase
+    *segment = 0;               // Dummy write starts the erase
+    FCTL1 = FWKEY;
+    FCTL3 = FWKEY + LOCK;
+    __bis_SR_register(state);
+}
+
+void flashWriteWords(unsigned int *dst, const unsigned int *src, unsigned char count) {
+    unsigned short state = __get_SR_register() & GIE;
+
+    __disable_interrupt();
+    FCTL3 = FWKEY;              // Clear LOCK
+    FCTL1 = FWKEY + WRT;        // Word write, one unlock for the whole batch
+    while (count--) {
+        *dst++ = *src++;
+    }
+    FCTL1 = FWKEY;
+    FCTL3 = FWKEY + LOCK;
+    __bis_SR_register(state);
+}
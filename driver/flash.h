@@ -0,0 +1,25 @@
+/*
+ * flash.h
+ *
+ * Segment erase and word writes of the internal flash (information memory or main memory below the image).
+ * The CPU is held while the flash is busy, interrupts stay off meanwhile so no vector is fetched from flash:
+ * about 15 ms per erase, 75 us per word. configFlash() sets the flash timing generator to MCLK / FLASH_DIV,
+ * inside the 257 .. 476 kHz the datasheet requires at every CLOCK_MHZ.
+ */
+
+#ifndef DRIVER_FLASH_H
+#define DRIVER_FLASH_H
+
+#include "config.h"
+
+#if CLOCK_MHZ == 1
+#define FLASH_DIV 3             // 333 kHz
+#else
+#define FLASH_DIV (CLOCK_MHZ * 5 / 2) // 400 kHz
+#endif
+
+void configFlash(void);
+void flashEraseSegment(unsigned int *segment); // Any address in the segment, 64 bytes INFO, 512 bytes main
+void flashWriteWords(unsigned int *dst, const unsigned int *src, unsigned char count); // Erased words only
+
+#endif
@@ -0,0 +1,36 @@
+#!/bin/sh
+# Flash and RAM bytes of every driver unit (and of the files given as arguments) for the selected options.
+# Usage: ./footprint.sh [-DCLOCK_MHZ=8 -DUART_RX ...] [../softwareUART/softwareUART_application3.c ...]
+# Needs msp430-elf-gcc/msp430-elf-size (TI MSP430 GCC) in PATH. Flash = text + data (initial values), RAM = data + bss.
+# Each function gets its own section, so the linker (--gc-sections) drops what an application does not call.
+
+CC=${CC:-msp430-elf-gcc}
+SIZE=${SIZE:-msp430-elf-size}
+DIR=$(dirname "$0")
+FLAGS="-mmcu=msp430g2553 -Os -ffunction-sections -fdata-sections -I$DIR"
+OUT=$(mktemp -d)
+trap 'rm -rf "$OUT"' EXIT
+
+DEFINES=""
+FILES=""
+for arg in "$@"; do
+    case "$arg" in
+        -D*) DEFINES="$DEFINES $arg" ;;
+        *) FILES="$FILES $arg" ;;
+    esac
+done
+
+printf "%-40s %6s %6s\n" "module" "flash" "ram"
+total_flash=0
+total_ram=0
+for src in "$DIR"/*.c $FILES; do
+    obj="$OUT/$(basename "$src" .c).o"
+    $CC $FLAGS $DEFINES -c "$src" -o "$obj" || exit 1
+    set -- $($SIZE "$obj" | tail -n 1)
+    flash=$(($1 + $2))
+    ram=$(($2 + $3))
+    total_flash=$((total_flash + flash))
+    total_ram=$((total_ram + ram))
+    printf "%-40s %6d %6d\n" "$(basename "$src")" "$flash" "$ram"
+done
+printf "%-40s %6d %6d   (FLASH 2014, RAM 256 incl. stack)\n" "total, before unused sections are removed" "$total_flash" "$total_ram"
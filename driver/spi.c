@@ -0,0 +1,88 @@
+#include "msp430.h"
+#include "spi.h"
+
+static const unsigned char *spiNext, *spiData;
+static unsigned int spiLeft, spiDataLeft;
+static volatile unsigned char spiActive = 0;
+
+void spiInit(void) {
+    UCB0CTL1 = UCSWRST;         // Hold the USCI while it is set up
+    UCB0CTL0 = UCCKPH + UCMSB + UCMST + UCSYNC; // Mode 0, MSB first, master, 3-pin SPI
+    UCB0CTL1 = UCSSEL_2 + UCSWRST; // SMCLK
+    UCB0BR0 = SPI_DIV & 0xFF;
+    UCB0BR1 = SPI_DIV >> 8;
+    P2OUT |= SPI_CS;            // Deselected
+    P2DIR |= SPI_CS;
+    P1SEL |= SPI_PINS;
+    P1SEL2 |= SPI_PINS;
+    UCB0CTL1 &= ~UCSWRST;
+}
+
+void spiSelect(void) {
+    P2OUT &= ~SPI_CS;
+}
+
+void spiDeselect(void) {
+    while (UCB0STAT & UCBUSY);  // Last bit out
+    P2OUT |= SPI_CS;
+}
+
+unsigned char spiXfer(unsigned char byte) {
+    while (!(IFG2 & UCB0TXIFG));
+    UCB0TXBUF = byte;
+    while (!(IFG2 & UCB0RXIFG)); // Shifted out and in
+    return UCB0RXBUF;
+}
+
+void spiWrite(const unsigned char *head, unsigned char headLength, const unsigned char *data,
+              unsigned int length) {
+    while (spiActive);
+    spiActive = 1;
+    spiNext = head + 1;
+    spiLeft = headLength - 1;
+    spiData = data;
+    spiDataLeft = length;
+    P2OUT &= ~SPI_CS;
+    UCB0TXBUF = *head;          // Straight into the idle shift register, TXIFG comes back at once
+    IE2 |= UCB0TXIE;
+}
+
+unsigned char spiBusy(void) {
+    return spiActive;
+}
+
+// Chip select high after the last byte, its RXIFG dropped
+static void spiEnd(void) {
+    (void)UCB0RXBUF;
+    P2OUT |= SPI_CS;
+    IE2 &= ~UCB0RXIE;
+    spiActive = 0;
+}
+
+#pragma vector = USCIAB0TX_VECTOR  // TXBUF empty: next byte of spiWrite()
+__interrupt void USCIAB0TX_ISR(void) {
+    if (!spiLeft && spiDataLeft) { // Head done, continue with the data
+        spiNext = spiData;
+        spiLeft = spiDataLeft;
+        spiDataLeft = 0;
+    }
+    if (spiLeft) {
+        UCB0TXBUF = *spiNext++;
+        spiLeft--;
+        return;
+    }
+    IE2 &= ~UCB0TXIE;           // The last byte is in the shift register
+    (void)UCB0RXBUF;            // Drop the RXIFG of the byte before, received bytes are not used
+    if (UCB0STAT & UCBUSY) {
+        IE2 |= UCB0RXIE;        // RXIFG again when the last byte is out
+    } else {
+        spiEnd();               // Already out while the ISR was delayed
+        __bic_SR_register_on_exit(LPM0_bits);
+    }
+}
+
+#pragma vector = USCIAB0RX_VECTOR  // Last byte of spiWrite() shifted out
+__interrupt void USCIAB0RX_ISR(void) {
+    spiEnd();
+    __bic_SR_register_on_exit(LPM0_bits); // Wake up main loop
+}
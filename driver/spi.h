@@ -0,0 +1,27 @@
+/*
+ * spi.h
+ *
+ * USCI_B0 as 3-pin SPI master: CLK P1.5, SOMI P1.6, SIMO P1.7, chip select SPI_CS on P2.0 as plain output.
+ * Mode 0 (the one 25-series flash and FRAM parts share with mode 3), MSB first, SMCLK / SPI_DIV.
+ * spiXfer() is polled for command bytes, spiWrite() clocks a header and a data block out from the USCIAB0TX ISR
+ * and raises chip select from the USCIAB0RX ISR once the last byte has left the shift register. Both vectors
+ * belong to this unit, USCI_A0 is not used by the repository.
+ */
+
+#ifndef DRIVER_SPI_H
+#define DRIVER_SPI_H
+
+#include "config.h"
+
+#define SPI_CS 0x01             // Chip select on P2.0, active low
+#define SPI_PINS 0xE0           // P1.5 UCB0CLK, P1.6 UCB0SOMI, P1.7 UCB0SIMO
+
+void spiInit(void);
+void spiSelect(void);
+void spiDeselect(void);         // After the last spiXfer(), it waits for the shift register
+unsigned char spiXfer(unsigned char byte); // One byte out, the byte clocked in meanwhile back
+void spiWrite(const unsigned char *head, unsigned char headLength, const unsigned char *data,
+              unsigned int length); // Select, head and data from the ISR, deselect; interrupts must be enabled
+unsigned char spiBusy(void);    // 1 until the chip select of spiWrite() is high again
+
+#endif
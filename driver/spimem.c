@@ -0,0 +1,66 @@
+#include "msp430.h"
+#include "spi.h"
+#include "spimem.h"
+
+#define CMD_PP 0x02             // Page program, write on FRAM
+#define CMD_READ 0x03
+#define CMD_RDSR 0x05
+#define CMD_WREN 0x06
+#define CMD_SE 0x20             // 4 KB sector erase
+#define STATUS_WIP 0x01
+
+static unsigned char spimemHead[4]; // Command and address of the write the ISR is clocking out
+
+// Command and 24-bit address, chip select stays low
+static void spimemCommand(unsigned char command, unsigned long address) {
+    spiSelect();
+    spiXfer(command);
+    spiXfer(address >> 16);
+    spiXfer(address >> 8);
+    spiXfer(address);
+}
+
+static void spimemWriteEnable(void) {
+    spiSelect();
+    spiXfer(CMD_WREN);
+    spiDeselect();
+}
+
+unsigned char spimemBusy(void) {
+    unsigned char status;
+
+    while (spiBusy());          // The bus belongs to spiWrite() until then
+    spiSelect();
+    spiXfer(CMD_RDSR);
+    status = spiXfer(0xFF);
+    spiDeselect();
+    return status & STATUS_WIP;
+}
+
+void spimemErase(unsigned long address) {
+#ifndef SPIMEM_FRAM
+    while (spimemBusy());
+    spimemWriteEnable();
+    spimemCommand(CMD_SE, address);
+    spiDeselect();              // Erase starts here
+#endif
+}
+
+void spimemProgram(unsigned long address, const unsigned char *data, unsigned int length) {
+    while (spimemBusy());
+    spimemWriteEnable();
+    spimemHead[0] = CMD_PP;
+    spimemHead[1] = address >> 16;
+    spimemHead[2] = address >> 8;
+    spimemHead[3] = address;
+    spiWrite(spimemHead, 4, data, length); // Programming starts when the ISR raises chip select
+}
+
+void spimemRead(unsigned long address, unsigned char *data, unsigned int length) {
+    while (spimemBusy());
+    spimemCommand(CMD_READ, address);
+    while (length--) {
+        *data++ = spiXfer(0xFF);
+    }
+    spiDeselect();
+}
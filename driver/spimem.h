@@ -0,0 +1,25 @@
+/*
+ * spimem.h
+ *
+ * 25-series SPI memory on spi.c: serial NOR flash (W25Q, AT25, MX25 ...) or with SPIMEM_FRAM an FRAM (MB85RS,
+ * FM25V ...). Both take WREN, RDSR, READ and page program/write with a 24-bit address.
+ * Flash programs only erased (0xFF) bytes, a page program must stay inside one SPIMEM_PAGE page and keeps the
+ * device busy (RDSR WIP) for about a millisecond after chip select goes high; a 4 KB sector erase for tens of ms.
+ * FRAM writes at bus speed and needs no erase, spimemErase() does nothing then.
+ */
+
+#ifndef DRIVER_SPIMEM_H
+#define DRIVER_SPIMEM_H
+
+#include "config.h"
+
+#define SPIMEM_PAGE 256
+#define SPIMEM_SECTOR 4096UL
+
+unsigned char spimemBusy(void); // 1 while a program or erase is in progress
+void spimemErase(unsigned long address); // Sector of the address, returns while the device erases
+void spimemProgram(unsigned long address, const unsigned char *data, unsigned int length); // Waits for the
+                                // previous write, then clocks data out from the ISR and returns at once
+void spimemRead(unsigned long address, unsigned char *data, unsigned int length);
+
+#endif
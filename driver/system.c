@@ -0,0 +1,25 @@
+#include "msp430.h"
+#include "system.h"
+
+void configWDT(void) {
+    WDTCTL = WDTPW | WDTHOLD;   // Stop watchdog timer
+}
+
+void configDCO(unsigned char mhz) {
+    DCOCTL = 0;                 // Lowest DCOx/MODx while RSEL changes, no overshoot
+    if (mhz == 16) {
+        BCSCTL1 = CALBC1_16MHZ; // Set DCO to 16 MHz
+        DCOCTL = CALDCO_16MHZ;
+    } else if (mhz == 8) {
+        BCSCTL1 = CALBC1_8MHZ;  // Set DCO to 8 MHz
+        DCOCTL = CALDCO_8MHZ;
+    } else {
+        BCSCTL1 = CALBC1_1MHZ;  // Set DCO to 1 MHz
+        DCOCTL = CALDCO_1MHZ;
+    }
+}
+
+void configClocks(void) {
+    configDCO(CLOCK_MHZ);
+    BCSCTL3 |= LFXT1S_2;        // Set VLO as the source for ACLK (~12 kHz)
+}
@@ -0,0 +1,16 @@
+/*
+ * system.h
+ *
+ * Watchdog and clock setup shared by every application.
+ */
+
+#ifndef DRIVER_SYSTEM_H
+#define DRIVER_SYSTEM_H
+
+#include "config.h"
+
+void configWDT(void);           // Stop the watchdog timer
+void configClocks(void);        // DCO at CLOCK_MHZ for MCLK/SMCLK, VLO (~12 kHz) for ACLK
+void configDCO(unsigned char mhz); // Calibrated DCO 1, 8 or 16 MHz at run time, see vcc.h for the Vcc it needs
+
+#endif
@@ -0,0 +1,295 @@
+#include "msp430.h"
+#include "uart.h"
+
+#ifndef REG16                   // Register through a pointer, host/msp430.h counts the access like a named one
+#define REG16(p) (*(p))
+#define REG8(p) (*(p))
+#endif
+
+struct uart uart0;
+#ifdef UART1
+struct uart uart1;
+#endif
+
+#ifdef UART_STATS
+static void uartStat(volatile struct uartStats *s, unsigned int armed, unsigned int tbit) {
+    if (armed >= 0x8000) {      // Before its own compare: a stale flag after an overrun, the bit is wrong
+        s->late++;
+        return;
+    }
+    if (armed > s->worst) s->worst = armed;
+    if (armed >= tbit) s->late++;
+    s->sum += armed;
+    s->bits++;
+}
+#endif
+
+void uartInit(struct uart *u) {
+    REG8(u->out) &= ~(u->txd + u->rxd);
+    REG8(u->dir) |= u->txd;
+    REG8(u->dir) &= ~u->rxd;
+    REG16(u->cctl0) = OUT;      // Set TXD idle as '1'
+    u->txBitCnt = 10;
+#ifdef UART_RING
+    u->txHead = u->txTail = 0;
+#endif
+#ifdef UART_RX
+    u->rxBitCnt = 8;
+#ifdef UART_RING
+    u->rxHead = u->rxTail = 0;
+    u->rxLost = 0;
+#else
+    u->rxReady = 0;
+#endif
+    REG8(u->sel) |= u->txd + u->rxd; // Use TXD/RXD pins
+    REG16(u->cctl1) = SCS + CM1 + CAP + CCIE; // RXD: sync, neg edge, capture, interrupt
+#else
+    REG8(u->sel) |= u->txd;     // Use TXD pin
+#endif
+    REG16(u->ctl) = TASSEL_2 + MC_2; // SMCLK, continuous mode
+}
+
+void uartTx(struct uart *u, unsigned char byte) {
+#ifdef UART_RING
+    unsigned char next = (u->txHead + 1) & (UART_TX_SIZE - 1);
+
+    __disable_interrupt();
+    while (next == u->txTail) { // Ring full, the TXD ISR wakes us after the next byte
+        __bis_SR_register(LPM0_bits + GIE);
+        __disable_interrupt();
+    }
+    if (REG16(u->cctl0) & CCIE) { // Transmitter busy, the ISR takes the byte after the stop bit
+        u->txRing[u->txHead] = byte;
+        u->txHead = next;
+        __enable_interrupt();
+        return;
+    }
+    __enable_interrupt();       // Idle: only this function starts a frame
+#else
+    while (REG16(u->cctl0) & CCIE); // Ensure last char TX'd
+#endif
+    u->txData = byte;           // Load char to be TXD
+    u->txData |= 0x100;         // Add mark stop bit to TXData
+    u->txData <<= 1;            // Add space start bit
+    REG16(u->ccr0) = REG16(u->r); // Current state of TA counter
+    REG16(u->ccr0) += u->tbit;  // One bit time till 1st bit
+    REG16(u->cctl0) = OUTMOD0 + CCIE; // Set TXD on EQU0, Int
+}
+
+unsigned char uartTxIdle(struct uart *u) {
+    return !(REG16(u->cctl0) & CCIE);
+}
+
+#if defined(UART_RING) && defined(UART_RX)
+unsigned char uartRxAvail(struct uart *u) {
+    return u->rxHead != u->rxTail;
+}
+
+unsigned char uartRx(struct uart *u) {
+    unsigned char byte = u->rxRing[u->rxTail];
+
+    u->rxTail = (u->rxTail + 1) & (UART_RX_SIZE - 1);
+    return byte;
+}
+#endif
+
+void uartClock(struct uart *u, unsigned long smclkHz, unsigned long baud) {
+    u->tbit = smclkHz / baud;
+}
+
+void uartPrint(struct uart *u, char *string) {
+    while (*string) uartTx(u, *string++);
+}
+
+void uartPrintNum(struct uart *u, unsigned int value) {
+    char digits[5];
+    unsigned char i = 0;
+
+    do {
+        digits[i++] = value % 10 + '0';
+        value /= 10;
+    } while (value);
+    while (i) uartTx(u, digits[--i]);
+}
+
+#ifdef UART_STATS
+void uartStatsClear(struct uart *u) {
+    unsigned short state = __get_SR_register() & GIE;
+
+    __disable_interrupt();
+    u->txStats.worst = u->txStats.late = 0;
+    u->txStats.sum = u->txStats.bits = 0;
+#ifdef UART_RX
+    u->rxStats.worst = u->rxStats.late = 0;
+    u->rxStats.sum = u->rxStats.bits = 0;
+#endif
+    __bis_SR_register(state);
+}
+#endif
+
+// CCR0 compare: next bit of the frame on TXD, 1 when a byte is complete and LPM0 should end (UART_RING)
+static unsigned char uartTxBit(struct uart *u) {
+    REG16(u->ccr0) += u->tbit;  // Set TACCR0 for next intrpt
+#ifdef UART_STATS
+    uartStat(&u->txStats, REG16(u->r) - (REG16(u->ccr0) - u->tbit), u->tbit);
+#endif
+    if (u->txBitCnt == 0) {     // All bits TXed?
+        u->txBitCnt = 10;       // Re-load bit counter
+#ifdef UART_RING
+        if (u->txTail != u->txHead) { // Next byte from the ring, the stop bit just goes on for one bit
+            u->txData = (u->txRing[u->txTail] | 0x100) << 1;
+            u->txTail = (u->txTail + 1) & (UART_TX_SIZE - 1);
+            return 1;
+        }
+        REG16(u->cctl0) &= ~CCIE; // Ring empty, disable intrpt
+        return 1;
+#else
+        REG16(u->cctl0) &= ~CCIE; // Yes, disable intrpt
+#endif
+    } else {
+        if (u->txData & 0x01) { // Check next bit to TX
+            REG16(u->cctl0) &= ~OUTMOD2; // TX '1' by OUTMODE0/OUT
+        } else {
+            REG16(u->cctl0) |= OUTMOD2; // TX '0'
+        }
+        u->txData >>= 1;
+        u->txBitCnt--;
+    }
+    return 0;
+}
+
+#ifdef UART_RX
+// CCR1 capture of the start bit or compare in the middle of a data bit, 1 when a byte is complete
+static unsigned char uartRxBit(struct uart *u) {
+#ifdef UART_RING
+    unsigned char next;
+#endif
+
+    REG16(u->ccr1) += u->tbit;  // Set TACCR1 for next int
+    if (REG16(u->cctl1) & CAP) { // On start bit edge
+        REG16(u->cctl1) &= ~(CAP + CCIFG); // Switch to compare mode, drop a capture of a data edge
+        REG16(u->ccr1) += u->tbit >> 1; // To middle of D0
+#ifdef UART_STATS
+        uartStat(&u->rxStats, REG16(u->r) - (REG16(u->ccr1) - u->tbit - (u->tbit >> 1)), u->tbit);
+#endif
+        return 0;
+    }
+#ifdef UART_STATS
+    uartStat(&u->rxStats, REG16(u->r) - (REG16(u->ccr1) - u->tbit), u->tbit);
+#endif
+    u->rxData >>= 1;            // Get next data bit
+    if (REG16(u->cctl1) & SCCI) { // Get bit from latch
+        u->rxData |= 0x80;
+    }
+    if (--u->rxBitCnt) {
+        return 0;
+    }
+#ifdef UART_RING
+    next = (u->rxHead + 1) & (UART_RX_SIZE - 1);
+    if (next != u->rxTail) {    // All bits RXed, store in the ring
+        u->rxRing[u->rxHead] = u->rxData;
+        u->rxHead = next;
+    } else {
+        u->rxLost++;
+    }
+#else
+    u->rxBuffer = u->rxData;    // All bits RXed, store in global
+    u->rxReady = 1;
+#endif
+    u->rxBitCnt = 8;            // Re-load bit counter
+    REG16(u->cctl1) = (REG16(u->cctl1) & ~CCIFG) | CAP; // Switch to capture, drop a compare
+    return 1;
+}
+#endif
+
+void TimerA_UART_init(void) {
+    uart0.ctl = &TA0CTL;
+    uart0.r = &TA0R;
+    uart0.cctl0 = &TA0CCTL0;
+    uart0.ccr0 = &TA0CCR0;
+    uart0.cctl1 = &TA0CCTL1;
+    uart0.ccr1 = &TA0CCR1;
+    uart0.out = &P1OUT;
+    uart0.dir = &P1DIR;
+    uart0.sel = &P1SEL;
+    uart0.txd = UART_TXD;
+    uart0.rxd = UART_RXD;
+    uart0.tbit = UART_TBIT;
+    uartInit(&uart0);
+}
+
+void TimerA_UART_tx(unsigned char byte) {
+    uartTx(&uart0, byte);
+}
+
+void TimerA_UART_print(char *string) {
+    uartPrint(&uart0, string);
+}
+
+void TimerA_UART_printNum(unsigned int value) {
+    uartPrintNum(&uart0, value);
+}
+
+#ifdef UART_STATS
+void TimerA_UART_statsClear(void) {
+    uartStatsClear(&uart0);
+}
+#endif
+
+#pragma vector = TIMER0_A0_VECTOR  // TXD interrupt
+__interrupt void Timer_A0_ISR(void) {
+    if (uartTxBit(&uart0)) {
+        __bic_SR_register_on_exit(LPM0_bits); // Room in the TX ring
+    }
+}
+
+#ifdef UART_RX
+#pragma vector = TIMER0_A1_VECTOR  // RXD interrupt
+__interrupt void Timer_A1_ISR(void) {
+    switch (__even_in_range(TA0IV, TA0IV_TAIFG)) {
+        case TA0IV_TACCR1:      // TACCR1 CCIFG - UART RXD
+            if (uartRxBit(&uart0)) {
+                __bic_SR_register_on_exit(LPM0_bits); // Wake up main loop
+            }
+            break;
+    }
+}
+#endif
+
+#ifdef UART1
+void TimerA1_UART_init(void) {
+    uart1.ctl = &TA1CTL;
+    uart1.r = &TA1R;
+    uart1.cctl0 = &TA1CCTL0;
+    uart1.ccr0 = &TA1CCR0;
+    uart1.cctl1 = &TA1CCTL1;
+    uart1.ccr1 = &TA1CCR1;
+    uart1.out = &P2OUT;
+    uart1.dir = &P2DIR;
+    uart1.sel = &P2SEL;
+    uart1.txd = UART1_TXD;
+    uart1.rxd = UART1_RXD;
+    uart1.tbit = UART1_TBIT;
+    uartInit(&uart1);
+}
+
+#pragma vector = TIMER1_A0_VECTOR  // TXD interrupt of the second port
+__interrupt void Timer1_A0_ISR(void) {
+    if (uartTxBit(&uart1)) {
+        __bic_SR_register_on_exit(LPM0_bits);
+    }
+}
+
+#ifdef UART_RX
+#pragma vector = TIMER1_A1_VECTOR  // RXD interrupt of the second port
+__interrupt void Timer1_A1_ISR(void) {
+    switch (__even_in_range(TA1IV, TA1IV_TAIFG)) {
+        case TA1IV_TACCR1:
+            if (uartRxBit(&uart1)) {
+                __bic_SR_register_on_exit(LPM0_bits);
+            }
+            break;
+    }
+}
+#endif
+#endif
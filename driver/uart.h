@@ -0,0 +1,105 @@
+/*
+ * uart.h
+ *
+ * Software UART on Timer_A: TXD on the OUT0 pin of the timer, RXD on the CCI1A pin with UART_RX.
+ * The timer runs from SMCLK in continuous mode and belongs to the UART: its A0 vector always, its A1 vector
+ * with UART_RX. A port is a struct uart, the engine reaches timer and port registers through its pointers.
+ *   uart0  Timer0_A, TXD P1.1 (TA0.OUT0), RXD P1.2 (TA0.CCI1A), UART_BAUD; TimerA_UART_init()
+ *   uart1  Timer1_A, TXD P2.0 (TA1.OUT0), RXD P2.1 (TA1.CCI1A), UART1_BAUD; TimerA1_UART_init(), only with UART1
+ * Without UART1 use Timer1_A for the timing of the application, with it nothing is left but the WDT interval.
+ * Interrupts must be enabled for uartTx, it waits for the previous byte of the port (with UART_RING: for room in
+ * the TX ring, the TXD ISR then also leaves LPM0 after every byte so that a sleeping program sees uartTxIdle change).
+ */
+
+#ifndef DRIVER_UART_H
+#define DRIVER_UART_H
+
+#include "config.h"
+
+#define UART_TXD 0x02           // TXD on P1.1 (Timer0_A.OUT0)
+#define UART_RXD 0x04           // RXD on P1.2 (Timer0_A.CCI1A)
+#define UART_TBIT (SMCLK_HZ / UART_BAUD) // Transmission time per bit = clock/baud rate
+
+#ifdef UART1
+#define UART1_TXD 0x01          // TXD on P2.0 (Timer1_A.OUT0)
+#define UART1_RXD 0x02          // RXD on P2.1 (Timer1_A.CCI1A)
+#define UART1_TBIT (SMCLK_HZ / UART1_BAUD)
+#endif
+
+#ifdef UART_STATS
+// Bit ISR timing: the output unit and the SCCI latch act exactly at the compare, a bit only leaves the ideal
+// grid when its compare is armed after the instant has passed (it then comes one timer period late).
+// The start bit capture is counted like a compare, its half bit of extra time is not used as margin.
+struct uartStats {
+    unsigned int worst;         // Most cycles from a compare to arming the next one
+    unsigned int late;          // Bits armed too late, at least one corrupted byte each
+    unsigned long sum;
+    unsigned long bits;
+};
+#endif
+
+struct uart {
+    volatile unsigned int *ctl, *r;       // TAxCTL, TAxR
+    volatile unsigned int *cctl0, *ccr0;  // TXD
+    volatile unsigned int *cctl1, *ccr1;  // RXD
+    volatile unsigned char *out, *dir, *sel; // Port of both pins
+    unsigned char txd, rxd;
+    unsigned int tbit;          // Cycles per bit
+    unsigned int txData;        // Frame being shifted out
+    unsigned char txBitCnt;
+#ifdef UART_RING
+    volatile unsigned char txRing[UART_TX_SIZE];
+    volatile unsigned char txHead, txTail;
+#endif
+#ifdef UART_RX
+    unsigned char rxBitCnt, rxData;
+#ifdef UART_RING
+    volatile unsigned char rxRing[UART_RX_SIZE];
+    volatile unsigned char rxHead, rxTail;
+    volatile unsigned int rxLost;    // Bytes dropped on a full RX ring
+#else
+    volatile unsigned char rxBuffer; // Last received character
+    volatile unsigned char rxReady;  // Set with rxBuffer, the RX ISR also leaves LPM0
+#endif
+#endif
+#ifdef UART_STATS
+    volatile struct uartStats txStats;
+#ifdef UART_RX
+    volatile struct uartStats rxStats;
+#endif
+#endif
+};
+
+extern struct uart uart0;
+#ifdef UART1
+extern struct uart uart1;
+#endif
+
+void uartInit(struct uart *u);  // Pins and timer of a port with all pointers, pins and tbit filled in
+void uartTx(struct uart *u, unsigned char byte);
+unsigned char uartTxIdle(struct uart *u); // 1: nothing left to send, uartTx would not wait
+#if defined(UART_RING) && defined(UART_RX)
+unsigned char uartRxAvail(struct uart *u); // 1: uartRx has a byte, the RX ISR leaves LPM0 for each one
+unsigned char uartRx(struct uart *u);   // Oldest byte of the RX ring, only after uartRxAvail
+#endif
+void uartClock(struct uart *u, unsigned long smclkHz, unsigned long baud); // New bit time, TX and RX idle
+void uartPrint(struct uart *u, char *string);
+void uartPrintNum(struct uart *u, unsigned int value);
+#ifdef UART_STATS
+void uartStatsClear(struct uart *u);
+#endif
+
+// uart0, the names of the single port driver
+void TimerA_UART_init(void);
+void TimerA_UART_tx(unsigned char byte);
+void TimerA_UART_print(char *string);
+void TimerA_UART_printNum(unsigned int value);
+#ifdef UART_STATS
+void TimerA_UART_statsClear(void);
+#endif
+
+#ifdef UART1
+void TimerA1_UART_init(void);
+#endif
+
+#endif
@@ -0,0 +1,37 @@
+#include "msp430.h"
+#include "adc.h"
+#include "vcc.h"
+
+#define VCC_FULL_SCALE 1000     // 1.5 V reference result from which 2.5 V is used, Vcc ~2.93 V
+
+unsigned int vccRead(void) {
+    unsigned int code;
+    unsigned long mv;
+
+    ADC10CTL0 &= ~ENC;          // INCH can only change with ENC cleared
+    ADC10CTL1 = INCH_11 + ADC10DIV_3; // Vcc/2, ADC10CLK/4
+    ADC10CTL0 = SREF_1 + ADC10SHT_3 + REFON + ADC10ON; // 1.5 V reference
+    __delay_cycles(CLOCK_MHZ * 30); // Reference settling, 30 us at the highest clock of the build
+    code = readADC();
+    if (code >= VCC_FULL_SCALE) {
+        ADC10CTL0 &= ~ENC;
+        ADC10CTL0 |= REF2_5V;   // 2.5 V reference
+        __delay_cycles(CLOCK_MHZ * 30);
+        code = readADC();
+        mv = code * 5000UL / 1023;
+    } else {
+        mv = code * 3000UL / 1023;
+    }
+    ADC10CTL0 &= ~ENC;
+    ADC10CTL0 = 0;              // Reference and ADC10 off
+    return (unsigned int)mv;
+}
+
+unsigned char vccMaxMHz(unsigned int mv) {
+    if (mv >= 3300 + VCC_MARGIN_MV) {
+        return 16;
+    } else if (mv >= 2100 + VCC_MARGIN_MV) {
+        return 8;
+    }
+    return 1;                   // Rated down to 1.8 V, nothing slower is calibrated
+}
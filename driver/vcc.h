@@ -0,0 +1,22 @@
+/*
+ * vcc.h
+ *
+ * Supply voltage from ADC10 channel 11 (Vcc/2) and the DCO frequency the datasheet rates at it:
+ * 16 MHz from 3.3 V, 8 MHz from 2.1 V (6 MHz at 1.8 V to 12 MHz at 2.7 V, linear), 1 MHz down to 1.8 V.
+ * vccRead() turns the reference and the ADC10 on for one or two conversions and off again, call it every few
+ * seconds between the conversions of the application (configADC() again afterwards). Needs adc.c.
+ * The 1.5 V reference covers Vcc up to 3.0 V, a full scale result is repeated against 2.5 V (rated from 2.9 V).
+ * The reference is uncalibrated (+-1.5 %), VCC_MARGIN_MV covers it and the drop until the next check.
+ */
+
+#ifndef DRIVER_VCC_H
+#define DRIVER_VCC_H
+
+#include "config.h"
+
+#define VCC_MARGIN_MV 100       // Kept above the rated minimum of a DCO frequency
+
+unsigned int vccRead(void);     // Vcc in mV
+unsigned char vccMaxMHz(unsigned int mv); // Highest calibrated DCO (16, 8, 1) rated at mv - VCC_MARGIN_MV
+
+#endif
@@ -0,0 +1,53 @@
+#include "msp430.h"
+#include "vlo.h"
+
+#define VLO_CAL_DIV 8           // ACLK divider during calibration (DIVA_3)
+#define VLO_CAL_PERIODS 4       // Divided ACLK periods averaged per calibration
+#if CLOCK_MHZ == 1
+#define VLO_CAL_ID ID_0
+#define VLO_CAL_HZ SMCLK_HZ
+#else
+#define VLO_CAL_ID ID_3
+#define VLO_CAL_HZ (SMCLK_HZ / 8)
+#endif
+
+unsigned int vloCalibrate(void) {
+    unsigned int first = 0, last = 0, timeout;
+    unsigned char periods;
+    unsigned long counts, hz;
+
+    TA0CTL = TACLR;             // Stop the timer while it is borrowed for the capture
+    BCSCTL1 |= DIVA_3;          // ACLK / 8 to lengthen the captured period
+    TA0CCTL0 = CM_1 + CCIS_1 + SCS + CAP; // Rising edge, CCI0B = ACLK, synchronous capture
+    TA0CTL = TASSEL_2 + VLO_CAL_ID + MC_2 + TACLR; // SMCLK, continuous mode
+
+    // The first capture is only the reference edge, the next VLO_CAL_PERIODS give full periods
+    for (periods = 0; periods <= VLO_CAL_PERIODS; periods++) {
+        TA0CCTL0 &= ~CCIFG;
+        timeout = 0;
+        while (!(TA0CCTL0 & CCIFG) && ++timeout); // Wait for the next ACLK/8 edge
+        if (!(TA0CCTL0 & CCIFG)) {
+            break;              // ACLK is not running
+        }
+        if (periods == 0) {
+            first = TA0CCR0;
+        }
+        last = TA0CCR0;
+    }
+
+    TA0CTL = TACLR;             // Stop the timer
+    TA0CCTL0 = 0;               // Back to compare mode, no interrupt
+    BCSCTL1 &= ~DIVA_3;         // Restore ACLK / 1
+    if (periods <= VLO_CAL_PERIODS) {
+        return 0;
+    }
+    counts = (unsigned int)(last - first); // Modulo 2^16 difference
+    if (!counts) {
+        return 0;
+    }
+    hz = (VLO_CAL_HZ * VLO_CAL_DIV * VLO_CAL_PERIODS + counts / 2) / counts;
+    if (hz < VLO_MIN_HZ || hz > VLO_MAX_HZ) {
+        return 0;
+    }
+    return (unsigned int)hz;
+}
@@ -0,0 +1,22 @@
+/*
+ * vlo.h
+ *
+ * VLO frequency measured against the calibrated DCO: ACLK / 8 is captured on CCI0B while Timer0_A counts SMCLK
+ * (divided by 8 above 1 MHz, so VLO_CAL_PERIODS periods at 4 kHz still fit 16 bits).
+ * vloCalibrate() borrows Timer0_A and the ACLK divider for about 3 ms at 12 kHz and leaves the timer stopped,
+ * configure it afterwards. It returns 0 when ACLK does not run or the result is outside the 4 .. 20 kHz the VLO
+ * reaches over temperature and Vcc; use VLO_NOMINAL_HZ then.
+ */
+
+#ifndef DRIVER_VLO_H
+#define DRIVER_VLO_H
+
+#include "config.h"
+
+#define VLO_NOMINAL_HZ 12000
+#define VLO_MIN_HZ 4000
+#define VLO_MAX_HZ 20000
+
+unsigned int vloCalibrate(void); // VLO in Hz, 0 on failure
+
+#endif
@@ -0,0 +1,233 @@
+/*
+Runtime configuration kept in information flash so the board does not recalibrate at every reset
+The temperature threshold (737), its offset, the sample period and the measured VLO frequency are stored as one
+versioned record with a CRC-16 instead of compile-time constants.
+Two slots, each in its own 64-byte erase unit: slot 0 in INFOD (0x1000), slot 1 in INFOC (0x1040).
+A slot holds one 32-byte record, the rest of its segment stays erased:
+  word 0 : CONFIG_MAGIC + CONFIG_VERSION      word 4 : sample period in seconds
+  word 1 : sequence number                    word 5 : temperature offset (signed ADC counts)
+  word 2 : VLO frequency in Hz                word 6..14 : reserved (0xFFFF)
+  word 3 : temperature threshold (737)        word 15 : CRC-16/CCITT of word 0..14
+1. Boot reads both slots and takes the valid record (magic, version, CRC, VLO in range) with the newer sequence
+   number, one validated read instead of a VLO calibration
+2. An update erases the segment of the other slot and writes the record there, the current record is never
+   touched: power loss during the erase or a torn write fails that slot and the old record is loaded at the
+   next boot
+Demo: temperature every samplePeriod seconds (Timer_A on ACLK with the stored VLO frequency), red LED above
+the threshold, green LED below. Pressing P1.3 recalibrates the VLO and stores the new record. A calibration that
+times out or lands outside the 4 .. 20 kHz of the VLO is never stored, the current record (or the 12 kHz
+default) stays in use.
+Build with ../driver/system.c ../driver/vlo.c ../driver/flash.c.
+*/
+
+#include "msp430.h"
+#include "../driver/system.h"
+#include "../driver/vlo.h"
+#include "../driver/flash.h"
+
+#define LED_RED BIT0    // P1.0 Red LED
+#define LED_GREEN BIT6  // P1.6 Green LED
+#define SW BIT3         // P1.3 Button
+
+#define CONFIG_MAGIC 0xC500
+#define CONFIG_VERSION 2        // 1: slots shared INFOD and held the unused baud rate and A1 threshold
+#define CONFIG_WORDS 16         // 32-byte record
+#define CONFIG_SLOTS 2
+#define CONFIG_FREE 0xFFFF
+
+struct config {
+    unsigned int magic;
+    unsigned int sequence;
+    unsigned int vloHz;
+    unsigned int tempThreshold;
+    unsigned int samplePeriod;
+    int tempOffset;
+    unsigned int reserved[9];
+    unsigned int crc;
+};
+
+struct config * const configSlot[CONFIG_SLOTS] = {
+    (struct config *)0x1000,    // INFOD
+    (struct config *)0x1040     // INFOC
+};
+
+struct config cfg;              // Working copy in RAM
+signed char cfgSlot = -1;       // Slot holding cfg, -1 = defaults only
+volatile unsigned char buttonPressed = 0;
+
+void configIO(void);
+void configADC10(void);
+void configTimerA(void);
+void configDefaults(void);
+unsigned char configLoad(void);
+void configSave(void);
+unsigned int crc16(const unsigned int *data, unsigned char words);
+
+void main(void) {
+    unsigned int temperature, vloHz;
+
+    configWDT();
+    configClocks();
+    configFlash();
+    configIO();
+    configADC10();
+
+    if (!configLoad()) {        // No valid record: defaults and one calibration
+        configDefaults();
+        vloHz = vloCalibrate();
+        if (vloHz) {            // Otherwise nothing is stored and the next boot calibrates again
+            cfg.vloHz = vloHz;
+            configSave();
+        }
+    }
+    configTimerA();
+    __enable_interrupt();
+
+    for (;;) {
+        __bis_SR_register(LPM3_bits + GIE); // Woken by the sample period or the button
+
+        if (buttonPressed) {
+            buttonPressed = 0;
+            vloHz = vloCalibrate(); // Field tuning without reflashing
+            if (vloHz) {        // A failed calibration keeps the stored record
+                cfg.vloHz = vloHz;
+                configSave();
+            }
+            configTimerA();
+            P1IFG &= ~SW;       // Bounces are over after the calibration
+            P1IE |= SW;
+            continue;
+        }
+
+        ADC10CTL0 |= ENC + ADC10SC;     // Sampling and conversion start
+        while (ADC10CTL1 & ADC10BUSY);  // Wait until conversion is complete
+        temperature = ADC10MEM + cfg.tempOffset;
+        if (temperature > cfg.tempThreshold) {
+            P1OUT = (P1OUT & ~LED_GREEN) | LED_RED;
+        } else {
+            P1OUT = (P1OUT & ~LED_RED) | LED_GREEN;
+        }
+    }
+}
+
+void configIO(void) {
+    P1DIR |= LED_RED + LED_GREEN;    // Set LED pins as outputs
+    P1OUT &= ~(LED_RED + LED_GREEN); // Turn off LEDs initially
+    P1DIR &= ~SW;             // Button with pull-up, falling edge interrupt
+    P1REN |= SW;
+    P1OUT |= SW;
+    P1IES |= SW;
+    P1IFG &= ~SW;
+    P1IE |= SW;
+}
+
+void configADC10(void) {
+    ADC10CTL1 = INCH_10 + ADC10DIV_3; // Temp Sensor ADC10CLK/4
+    ADC10CTL0 = SREF_1 + ADC10SHT_3 + REFON + ADC10ON; // Internal ref on, ADC on
+}
+
+// Sample period from the stored VLO frequency, Timer_A from ACLK in up mode
+void configTimerA(void) {
+    TA0CTL = TACLR;
+    TA0CCR0 = cfg.vloHz - 1;
+    TA0CCTL0 = CCIE;
+    TA0CTL = TASSEL_1 + MC_1 + TACLR;  // ACLK, up mode
+}
+
+void configDefaults(void) {
+    unsigned char i;
+
+    cfg.magic = CONFIG_MAGIC + CONFIG_VERSION;
+    cfg.sequence = 0;
+    cfg.vloHz = VLO_NOMINAL_HZ;
+    cfg.tempThreshold = 737;
+    cfg.samplePeriod = 1;
+    cfg.tempOffset = 0;
+    for (i = 0; i < 9; i++) {
+        cfg.reserved[i] = CONFIG_FREE;
+    }
+    cfgSlot = -1;
+}
+
+// Load the newest valid record, returns 0 if there is none
+unsigned char configLoad(void) {
+    unsigned char slot;
+    struct config *c;
+
+    cfgSlot = -1;
+    for (slot = 0; slot < CONFIG_SLOTS; slot++) {
+        c = configSlot[slot];
+        if (c->magic != CONFIG_MAGIC + CONFIG_VERSION) {
+            continue;           // Free, older layout or invalidated
+        }
+        if (c->crc != crc16((const unsigned int *)c, CONFIG_WORDS - 1)) {
+            continue;           // Torn write
+        }
+        if (c->vloHz < VLO_MIN_HZ || c->vloHz > VLO_MAX_HZ) {
+            continue;           // Not a VLO frequency
+        }
+        if (cfgSlot < 0 || (int)(c->sequence - configSlot[cfgSlot]->sequence) > 0) {
+            cfgSlot = slot;
+        }
+    }
+    if (cfgSlot < 0) {
+        return 0;
+    }
+    cfg = *configSlot[cfgSlot];
+    return 1;
+}
+
+// Store cfg as a new record in the slot that does not hold the current one, erasing only that slot's segment
+void configSave(void) {
+    unsigned char target, i;
+    unsigned int *slot;
+
+    cfg.magic = CONFIG_MAGIC + CONFIG_VERSION;
+    cfg.sequence++;
+    cfg.crc = crc16((const unsigned int *)&cfg, CONFIG_WORDS - 1);
+
+    target = cfgSlot == 0 ? 1 : 0;
+    slot = (unsigned int *)configSlot[target];
+    for (i = 0; i < CONFIG_WORDS; i++) {
+        if (slot[i] != CONFIG_FREE) {
+            flashEraseSegment(slot);    // An older record, the current one is in the other segment
+            break;
+        }
+    }
+    flashWriteWords(slot, (const unsigned int *)&cfg, CONFIG_WORDS);
+    cfgSlot = target;
+}
+
+// CRC-16/CCITT (polynomial 0x1021, init 0xFFFF) over whole words, low byte first
+unsigned int crc16(const unsigned int *data, unsigned char words) {
+    unsigned int crc = 0xFFFF;
+    unsigned char i, bit, byte;
+
+    for (i = 0; i < words * 2; i++) {
+        byte = i & 1 ? data[i >> 1] >> 8 : data[i >> 1] & 0xFF;
+        crc ^= (unsigned int)byte << 8;
+        for (bit = 0; bit < 8; bit++) {
+            crc = crc & 0x8000 ? (crc << 1) ^ 0x1021 : crc << 1;
+        }
+    }
+    return crc;
+}
+
+#pragma vector = TIMER0_A0_VECTOR  // One second elapsed
+__interrupt void Timer_A0_ISR(void) {
+    static unsigned int seconds = 0;
+    if (++seconds >= cfg.samplePeriod) {
+        seconds = 0;
+        __bic_SR_register_on_exit(LPM3_bits); // Wake up main loop
+    }
+}
+
+#pragma vector = PORT1_VECTOR
+__interrupt void Port_1(void) {
+    if (P1IFG & SW) {
+        buttonPressed = 1;
+        P1IE &= ~SW;            // Ignore the bounce, enabled again by main
+        P1IFG &= ~SW;
+        __bic_SR_register_on_exit(LPM3_bits);
+    }
+}
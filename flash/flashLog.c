@@ -0,0 +1,240 @@
+/*
+Temperature log in information flash that survives resets
+MSP430 measures the temperature every second and keeps the average of every LOG_PERIOD seconds in flash
+instead of one previous value in RAM.
+Flash layout: INFOA holds the DCO calibration, INFOD and INFOC the two slots of flash/configStore.c.
+The G2553 has 16 KB of main flash but lnk_msp430g2253.cmd links the image into the top 2 KB (0xF800), so the log
+rotates over the two 512-byte main segments below it, 0xF400 and 0xF600:
+  word 0      : sequence number of the segment, 0xFFFF = erased
+  word 1..255 : samples, 0xFFFF = free (a 10-bit ADC reading is never 0xFFFF)
+1. Samples are staged in RAM and written LOG_BATCH at a time with one unlock of the flash controller
+2. When a segment is full the next one in the ring is erased and gets sequence + 1, so every segment
+   is erased equally often (wear leveling) and the oldest data is overwritten first
+3. At boot the segment with the newest sequence number and its first free word give the head again,
+   a reset or power loss loses at most the samples still in RAM
+Endurance: 10000 erase cycles per segment, one erase per 2 segments * 255 samples * 60 s -> about 9 years.
+Interrupts are off while the flash is busy (about 15 ms per erase), a character from the PC may be lost then.
+Commands from the PC: 'D' dumps all samples oldest first (3 hex digits, 16 per line), 'E' erases the log.
+UART: Timer0_A, 9600 baud, 8-bit data, 1 stop bit, SMCLK at 1MHz. Timer1_A (ACLK, VLO) gives the 1 second tick.
+Build with ../driver/system.c ../driver/uart.c ../driver/flash.c and -DUART_RX.
+*/
+
+#include "msp430.h"
+#include "../driver/system.h"
+#include "../driver/uart.h"
+#include "../driver/flash.h"
+
+#ifndef UART_RX
+#error "flashLog.c takes its commands from uart0.rxReady, build with -DUART_RX"
+#endif
+
+#define LOG_SEGMENTS 2
+#define LOG_SEGMENT_WORDS 256   // 512-byte main flash segment
+#define LOG_FREE 0xFFFF
+#define LOG_BATCH 8             // Samples staged in RAM before a flash write
+#define LOG_PERIOD 60           // Seconds averaged into one logged sample
+
+unsigned int * const logSegment[LOG_SEGMENTS] = {
+    (unsigned int *)0xF400,     // Below the linked image, reflashing erases the log with the main memory
+    (unsigned int *)0xF600
+};
+
+volatile unsigned char secondTick = 0;
+
+unsigned char logHead;          // Segment being filled
+unsigned int logIndex;          // Next free word in it
+unsigned int logStaged[LOG_BATCH];
+unsigned char logStagedCount = 0;
+
+void configP1_UART(void);
+void configADC(void);
+void configTimer1s(void);
+void TimerA_UART_printHex(unsigned int value);
+void logRecover(void);
+void logAppend(unsigned int sample);
+void logFlush(void);
+void logErase(void);
+void logDump(void);
+unsigned int readTemperature(void);
+
+void main(void) {
+    unsigned long periodSum = 0;
+    unsigned char periodSeconds = 0;
+
+    configWDT();
+    configClocks();
+    configP1_UART();
+    TimerA_UART_init();
+    configADC();
+    configFlash();
+    configTimer1s();
+    logRecover();
+    __enable_interrupt();
+
+    TimerA_UART_print("Flash log READY.\r\n");
+
+    for (;;) {
+        __bis_SR_register(LPM0_bits); // Woken by the 1 second tick or a command
+        if (secondTick) {
+            secondTick = 0;
+            periodSum += readTemperature();
+            if (++periodSeconds == LOG_PERIOD) {
+                logAppend((unsigned int)(periodSum / LOG_PERIOD));
+                periodSum = 0;
+                periodSeconds = 0;
+            }
+        }
+        if (uart0.rxReady) {
+            uart0.rxReady = 0;
+            if (uart0.rxBuffer == 'D') {
+                logDump();
+            } else if (uart0.rxBuffer == 'E') {
+                logErase();
+                TimerA_UART_print("ERASED\r\n");
+            }
+        }
+    }
+}
+
+void configP1_UART(void) {
+    P1OUT = 0x00;             // Initialize all GPIO
+    P1DIR = 0xFF & ~UART_RXD; // Set pins to output, TimerA_UART_init selects TXD/RXD
+}
+
+void configADC(void) {
+    ADC10CTL1 = INCH_10 + ADC10DIV_3; // Temp Sensor ADC10CLK/4
+    ADC10CTL0 = SREF_1 + ADC10SHT_3 + REFON + ADC10ON; // Internal ref on, ADC on
+}
+
+unsigned int readTemperature(void) {
+    ADC10CTL0 |= ENC + ADC10SC; // Sampling and conversion start
+    while (ADC10CTL1 & ADC10BUSY); // Wait until conversion is complete
+    return ADC10MEM;
+}
+
+// Find the newest segment and its first free word after a reset
+void logRecover(void) {
+    unsigned char seg, newest = LOG_SEGMENTS;
+    unsigned int seq, newestSeq = 0;
+
+    for (seg = 0; seg < LOG_SEGMENTS; seg++) {
+        seq = logSegment[seg][0];
+        if (seq == LOG_FREE) {
+            continue;
+        }
+        if (newest == LOG_SEGMENTS || (int)(seq - newestSeq) > 0) { // Wrap-safe comparison
+            newest = seg;
+            newestSeq = seq;
+        }
+    }
+
+    if (newest == LOG_SEGMENTS) { // Empty log
+        logErase();
+        return;
+    }
+    logHead = newest;
+    for (logIndex = 1; logIndex < LOG_SEGMENT_WORDS; logIndex++) {
+        if (logSegment[logHead][logIndex] == LOG_FREE) {
+            break;
+        }
+    }
+}
+
+void logAppend(unsigned int sample) {
+    logStaged[logStagedCount++] = sample;
+    if (logStagedCount == LOG_BATCH) {
+        logFlush();
+    }
+}
+
+// Write the staged samples, opening the next segment of the ring when the current one is full
+void logFlush(void) {
+    unsigned char done = 0, count;
+    unsigned int room;
+    unsigned int seq;
+
+    while (done < logStagedCount) {
+        if (logIndex == LOG_SEGMENT_WORDS) {
+            seq = logSegment[logHead][0] + 1;
+            if (seq == LOG_FREE) {
+                seq = 0;
+            }
+            logHead = (logHead + 1) % LOG_SEGMENTS;
+            flashEraseSegment(logSegment[logHead]); // Oldest segment
+            flashWriteWords(logSegment[logHead], &seq, 1);
+            logIndex = 1;
+        }
+        room = LOG_SEGMENT_WORDS - logIndex;
+        count = logStagedCount - done;
+        if (count > room) {
+            count = (unsigned char)room;
+        }
+        flashWriteWords(&logSegment[logHead][logIndex], &logStaged[done], count);
+        logIndex += count;
+        done += count;
+    }
+    logStagedCount = 0;
+}
+
+void logErase(void) {
+    unsigned char seg;
+    unsigned int seq = 0;
+
+    for (seg = 0; seg < LOG_SEGMENTS; seg++) {
+        flashEraseSegment(logSegment[seg]);
+    }
+    flashWriteWords(logSegment[0], &seq, 1);
+    logHead = 0;
+    logIndex = 1;
+    logStagedCount = 0;
+}
+
+// Send every sample oldest first: the segments after the head in ring order, then the RAM staging buffer
+void logDump(void) {
+    unsigned char n, seg, column = 0;
+    unsigned int i;
+    unsigned int *data;
+
+    for (n = 1; n <= LOG_SEGMENTS; n++) {
+        seg = (logHead + n) % LOG_SEGMENTS;
+        data = logSegment[seg];
+        if (data[0] == LOG_FREE) {
+            continue;               // Never used
+        }
+        for (i = 1; i < LOG_SEGMENT_WORDS && data[i] != LOG_FREE; i++) {
+            TimerA_UART_printHex(data[i]);
+            if (++column == 16) {
+                column = 0;
+                TimerA_UART_print("\r\n");
+            }
+        }
+    }
+    for (i = 0; i < logStagedCount; i++) {
+        TimerA_UART_printHex(logStaged[i]);
+        if (++column == 16) {
+            column = 0;
+            TimerA_UART_print("\r\n");
+        }
+    }
+    TimerA_UART_print("\r\nEND\r\n");
+}
+
+void TimerA_UART_printHex(unsigned int value) {
+    static const char hex[] = "0123456789ABCDEF";
+    TimerA_UART_tx(hex[(value >> 8) & 0x0F]);
+    TimerA_UART_tx(hex[(value >> 4) & 0x0F]);
+    TimerA_UART_tx(hex[value & 0x0F]);
+    TimerA_UART_tx(' ');
+}
+
+void configTimer1s(void) {
+    TA1CCR0 = 12000 - 1;      // 1 second from ACLK (VLO ~12 kHz)
+    TA1CCTL0 = CCIE;
+    TA1CTL = TASSEL_1 + MC_1 + TACLR; // ACLK, up mode
+}
+
+#pragma vector = TIMER1_A0_VECTOR  // 1 second tick
+__interrupt void Timer1_A0_ISR(void) {
+    secondTick = 1;
+    __bic_SR_register_on_exit(LPM0_bits); // Wake up main loop
+}
@@ -0,0 +1,39 @@
+#!/bin/sh
+# Compile programs of this repository for the host model, see README.md.
+# Usage: host/hostcc.sh -o program [-Doption ...] [-g -O2 ...] source.c [driver/uart.c ...]
+# Each source is copied with "#pragma vector = X" turned into HOST_VECTOR(X), which puts the following
+# handler into the section hostvec_X where model.c finds it. main() of the program becomes hostAppMain().
+# The sources are compiled with int = short, the 16-bit int of the MSP430: timer differences like TA0R - start
+# and CCR0 += n wrap at 0xFFFF as on the target. long stays 64 bits (-Dlong= cannot work: it would be rescanned
+# into short, break long long and leave UL constants 64 bits), see the limits in README.md.
+
+HOST=$(cd "$(dirname "$0")" && pwd)
+CC=${CC:-gcc}
+OUTPUT=a.out
+FLAGS=""
+SOURCES=""
+
+while [ $# -gt 0 ]; do
+    case "$1" in
+        -o) OUTPUT=$2; shift ;;
+        *.c) SOURCES="$SOURCES $1" ;;
+        *) FLAGS="$FLAGS $1" ;;
+    esac
+    shift
+done
+[ -n "$SOURCES" ] || { echo "usage: $0 -o program [flags] source.c ..." >&2; exit 2; }
+
+TMP=$(mktemp -d)
+trap 'rm -rf "$TMP"' EXIT
+OBJECTS=""
+n=0
+for src in $SOURCES; do
+    n=$((n + 1))
+    copy="$TMP/$n-$(basename "$src")"
+    printf '#line 1 "%s"\n' "$src" > "$copy"
+    sed 's/^[[:space:]]*#pragma[[:space:]]*vector[[:space:]]*=[[:space:]]*\([A-Za-z0-9_]*\).*/HOST_VECTOR(\1)/' "$src" >> "$copy"
+    $CC $FLAGS -I"$HOST" -iquote "$(dirname "$src")" -Dmain=hostAppMain -Dint=short -Wno-main -c "$copy" -o "$copy.o" || exit 1
+    OBJECTS="$OBJECTS $copy.o"
+done
+$CC $FLAGS -I"$HOST" -c "$HOST/model.c" -o "$TMP/model.o" || exit 1
+$CC $FLAGS $OBJECTS "$TMP/model.o" -o "$OUTPUT"
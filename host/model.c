@@ -0,0 +1,1322 @@
+/*
+ * model.c
+ *
+ * Register-level model of the MSP430G2553 parts the programs use, so they run on the host, see README.md.
+ * One call of hostStep() is one DCO cycle:
+ * 1. Stimulus events that are due change input pins, ADC10 inputs, Vcc or the VLO frequency, a stream drives RX
+ * 2. SMCLK (DCO / DIVS, stopped by SCG1) and ACLK (VLO or 32768 Hz / DIVA, stopped by OSCOFF) tick
+ * 3. Port pins are resolved (timer outputs, PxOUT, driven inputs, pull resistors), edges set PxIFG
+ * 4. Timer0_A/Timer1_A: capture inputs, counting in up (up/down is counted as up) and continuous mode,
+ *    compare, output units (OUTMOD_0..7), TAIFG
+ * 5. ADC10: ADC10SC or Timer0_A OUT1/OUT0/OUT2 trigger (SHS_1..3), conversion time from ADC10SHT/ADC10DIV/ADC10SSEL,
+ *    INCH_11 is Vcc/2 against the selected reference unless the script sets it
+ * 6. Watchdog: reset (the run ends) or interval mode
+ * 7. The TX line is decoded as UART at the script baud rate, every edge is compared with the ideal bit grid
+ * 8. USCI_B0 as SPI master shifts TXBUF out at BRCLK / UCB0BR, the SPI memory of the script on P1.5..P1.7 and
+ *    its chip select answers
+ * With GIE set, the highest priority pending interrupt is served after the step like on the CPU: SR saved,
+ * GIE and the LPM bits cleared, 6 cycles, the handler, 5 cycles, SR restored (with __bic_SR_register_on_exit
+ * applied). The handlers are found through the hostvec_<vector> sections made by hostcc.sh.
+ * The main loop of the program runs as it is; time passes HOST_ACCESS_CYCLES per register access and while the
+ * CPU is in LPM. A program spinning on a RAM flag is noticed by a host timer which then lets time pass too.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <signal.h>
+#include <sys/time.h>
+#include "msp430.h"
+
+#undef main                     // hostcc.sh renames main() of the program to hostAppMain()
+
+#define PS_PER_S 1000000000000ULL
+#define MAX_EVENTS 4096
+#define TX_LOG_SIZE 65536
+#define TX_PRINT 2048           // Only the end of a longer TX log is printed
+#define MAX_EXPECT 32
+#define SR_STACK 8
+#define STALL_CYCLES 1000        // Cycles granted when the program spins without a register access
+#define WRAP_CYCLES (1ULL << 32) // 32-bit cycle counts of a program wrap here on the MSP430, not with a 64-bit long
+
+#define X(r) volatile unsigned char host_##r;
+HOST_REGISTERS8
+#undef X
+#define X(r) volatile unsigned short host_##r;
+HOST_REGISTERS16
+#undef X
+
+unsigned short hostSR = 0;
+
+void hostAppMain(void);
+
+// Interrupt vectors, highest priority first
+#define HOST_VECTORS X(TIMER1_A0) X(TIMER1_A1) X(COMPARATORA) X(WDT) X(TIMER0_A0) X(TIMER0_A1) \
+    X(USCIAB0RX) X(USCIAB0TX) X(ADC10) X(PORT2) X(PORT1)
+
+#define X(v) extern void __start_hostvec_##v##_VECTOR(void) __attribute__((weak));
+HOST_VECTORS
+#undef X
+
+enum {
+#define X(v) VEC_##v,
+    HOST_VECTORS
+#undef X
+    VECTORS
+};
+
+struct vector {
+    const char *name;
+    void (*handler)(void);
+    unsigned long count;
+};
+
+static struct vector vectors[VECTORS] = {
+#define X(v) {#v, __start_hostvec_##v##_VECTOR, 0},
+    HOST_VECTORS
+#undef X
+};
+
+struct timer {
+    volatile unsigned short *ctl, *r, *iv;
+    volatile unsigned short *cctl[3], *ccr[3];
+    unsigned char out[3];       // Output units
+    unsigned char outRise[3];   // Output went high in this step
+    unsigned char cci[3];       // Capture inputs in the last step
+    unsigned int prescale;
+};
+
+static struct timer timers[2] = {
+    {&host_TA0CTL, &host_TA0R, &host_TA0IV, {&host_TA0CCTL0, &host_TA0CCTL1, &host_TA0CCTL2},
+     {&host_TA0CCR0, &host_TA0CCR1, &host_TA0CCR2}, {0}, {0}, {0}, 0},
+    {&host_TA1CTL, &host_TA1R, &host_TA1IV, {&host_TA1CCTL0, &host_TA1CCTL1, &host_TA1CCTL2},
+     {&host_TA1CCR0, &host_TA1CCR1, &host_TA1CCR2}, {0}, {0}, {0}, 0},
+};
+
+enum { EV_PIN, EV_RELEASE, EV_ADC, EV_VLO, EV_VCC };
+
+struct event {
+    unsigned long long ps;
+    unsigned int order;         // Keeps the script order for equal times
+    unsigned char kind, port, mask;
+    unsigned int value;
+};
+
+struct expect {
+    unsigned char kind;
+    char text[64];
+    int vector;
+    unsigned long min, max;
+};
+
+enum { EXPECT_TX, EXPECT_WAKEUPS, EXPECT_ISR, EXPECT_BIT_ERROR, EXPECT_SPIMEM };
+
+static struct event events[MAX_EVENTS];
+static unsigned int eventCount = 0, nextEvent = 0;
+static struct expect expects[MAX_EXPECT];
+static unsigned int expectCount = 0;
+
+static unsigned long long now = 0;      // Simulated time in ps
+static unsigned long long endPs = PS_PER_S;
+static unsigned long long activePs = 0;
+static unsigned long long cycles = 0;
+static unsigned long wakeups = 0;
+
+static unsigned short savedSR[SR_STACK];
+static unsigned char isrDepth = 0;
+static unsigned char modelDepth = 0;
+static unsigned long long stallMark = ~0ULL;
+
+// Clocks
+static unsigned long vloHz = 12000;
+static unsigned long long aclkAcc = 0;
+static unsigned char aclkLevel = 0, aclkDiv = 0;
+static unsigned char smclkDiv = 0;
+
+// Ports: driven inputs and resolved pin levels, index 0 = P1
+static unsigned char extDriven[2] = {0, 0}, extLevel[2] = {0xFF, 0xFF};
+static unsigned char pinLevel[2] = {0, 0};
+static unsigned char taclkRise = 0;
+
+// ADC10
+static unsigned int adcInput[16] = {512, 512, 512, 512, 512, 512, 512, 512,
+                                    512, 512, 740, 1023, 512, 512, 512, 512};
+static unsigned int adcFixed = 0;      // Channels set by the script
+static unsigned char adcBusy = 0;
+
+// Supply: the DCO must stay within the rated frequency of the datasheet for Vcc
+static unsigned int vccMv = 3600, vccMin = 3600;
+static unsigned char vccScripted = 0;
+static unsigned long long overclockPs = 0, overclockFirst = 0;
+static unsigned long long adcDonePs;
+static unsigned long adcConversions = 0;
+
+// Watchdog
+static unsigned long wdtCount = 0;
+
+// UART lines of the script
+static unsigned long baud = 9600;
+static unsigned char txPort = 0, txMask = BIT1, rxPort = 0, rxMask = BIT2;
+static char txLog[TX_LOG_SIZE];
+static unsigned int txLength = 0;
+static unsigned char txBusy = 0, txLast = 1, txBit;
+static unsigned int txData;
+static unsigned long long txStart;
+static unsigned long txFrames = 0, txErrors = 0;
+static unsigned long long txMaxDev = 0;
+#define STREAMS 2               // One per soft UART port
+static struct stream {
+    unsigned long long ps, bit;
+    unsigned long bytes;
+    unsigned char stop, port, mask;
+} streams[STREAMS];
+static unsigned char streamCount = 0;
+
+// USCI_B0 SPI master: TXBUF, shift register, RXBUF
+static unsigned char usciTxWritten = 0, usciTxFull = 0, usciShifting = 0, usciShift;
+static unsigned long usciLeft;          // BRCLK cycles until the byte is shifted
+
+// 25-series SPI memory on the USCI_B0 pins: flash (page program, sector erase, busy) or FRAM (writes at once)
+#define SPIMEM_SIZE 0x100000UL          // 8 Mbit, addresses wrap
+#define SPIMEM_PAGE 256
+#define SPIMEM_SECTOR 4096
+#define SPIMEM_REPORTED 8               // Protocol errors printed, all are counted
+enum { MEMORY_NONE, MEMORY_FLASH, MEMORY_FRAM };
+enum { MEM_WRSR = 0x01, MEM_PP = 0x02, MEM_READ = 0x03, MEM_WRDI = 0x04, MEM_RDSR = 0x05, MEM_WREN = 0x06,
+       MEM_SE = 0x20 };
+static struct spimem {
+    unsigned char kind, port, cs, selected, cmd, wel, miso;
+    unsigned long count;                // Bytes since chip select
+    unsigned long addr;
+    unsigned long long busyPs, programPs, erasePs;
+    unsigned char *data;
+    unsigned char latch[SPIMEM_PAGE], latched[SPIMEM_PAGE];
+    unsigned long programs, programmed, erases, read, errors;
+} mem = {MEMORY_NONE, 0, 0, 0, 0, 0, 0xFF, 0, 0, 0, 0, 0, NULL, {0}, {0}, 0, 0, 0, 0, 0};
+
+static void hostFinish(int status);
+
+static unsigned long long dcoPeriod(void) {
+    unsigned char rsel = host_BCSCTL1 & 0x0F;
+
+    if (rsel <= 7) {
+        return PS_PER_S / 1000000;
+    } else if (rsel <= 13) {
+        return PS_PER_S / 8000000;
+    }
+    return PS_PER_S / 16000000;
+}
+
+// Highest rated system frequency at Vcc: 6 MHz at 1.8 V, 12 MHz at 2.7 V, 16 MHz at 3.3 V, linear between
+static unsigned long ratedHz(unsigned int mv) {
+    if (mv < 1800) {
+        return 0;
+    } else if (mv < 2700) {
+        return 6000000UL + (mv - 1800) * 6000000UL / 900;
+    } else if (mv < 3300) {
+        return 12000000UL + (mv - 2700) * 4000000UL / 600;
+    }
+    return 16000000UL;
+}
+
+static unsigned char timerPin(unsigned char port, unsigned char bit, unsigned char *level) {
+    if (port == 0) {
+        switch (bit) {
+            case BIT1: case BIT5: *level = timers[0].out[0]; return 1;
+            case BIT2: case BIT6: *level = timers[0].out[1]; return 1;
+        }
+    } else {
+        switch (bit) {
+            case BIT0: case BIT3: *level = timers[1].out[0]; return 1;
+            case BIT1: case BIT2: *level = timers[1].out[1]; return 1;
+            case BIT4: case BIT5: *level = timers[1].out[2]; return 1;
+        }
+    }
+    return 0;
+}
+
+// Level of every pin of a port: outputs, timer outputs, driven inputs, pull resistors, floating reads 1
+static unsigned char resolvePort(unsigned char port) {
+    unsigned char dir = port ? host_P2DIR : host_P1DIR;
+    unsigned char out = port ? host_P2OUT : host_P1OUT;
+    unsigned char sel = port ? host_P2SEL : host_P1SEL;
+    unsigned char sel2 = port ? host_P2SEL2 : host_P1SEL2;
+    unsigned char ren = port ? host_P2REN : host_P1REN;
+    unsigned char levels = 0, bit, level;
+
+    for (bit = 1; bit; bit <<= 1) {
+        if (dir & bit) {
+            if ((sel & bit) && !(sel2 & bit) && timerPin(port, bit, &level)) {
+                level = level ? bit : 0;
+            } else {
+                level = out & bit;
+            }
+        } else if (extDriven[port] & bit) {
+            level = extLevel[port] & bit;
+        } else if (ren & bit) {
+            level = out & bit;
+        } else {
+            level = bit;
+        }
+        levels |= level;
+    }
+    return levels;
+}
+
+static void portStep(void) {
+    unsigned char port, levels, changed, ies;
+    volatile unsigned char *in, *ifg;
+
+    for (port = 0; port < 2; port++) {
+        in = port ? &host_P2IN : &host_P1IN;
+        ifg = port ? &host_P2IFG : &host_P1IFG;
+        ies = port ? host_P2IES : host_P1IES;
+        levels = resolvePort(port);
+        changed = levels ^ pinLevel[port];
+        *ifg |= changed & ((levels & ~ies) | (~levels & ies)); // IES 0: rising, 1: falling
+        if (port == 0) {
+            taclkRise = changed & levels & BIT0; // P1.0 = TA0CLK
+        }
+        pinLevel[port] = levels;
+        *in = levels;
+    }
+}
+
+static unsigned char captureInput(unsigned char timer, unsigned char channel, unsigned int cctl) {
+    static const unsigned char pinA[2][3] = {{BIT1, BIT2, 0}, {BIT0, BIT1, BIT4}};
+    static const unsigned char pinB[2][3] = {{0, 0, 0}, {BIT3, BIT2, BIT5}};
+
+    switch (cctl & CCIS_3) {
+        case CCIS_0:
+            return (pinLevel[timer] & pinA[timer][channel]) != 0;
+        case CCIS_1:
+            if (timer == 0 && channel != 1) {
+                return aclkLevel;       // CCI0B, CCI2B = ACLK
+            }
+            if (timer == 0) {
+                return (host_CACTL2 & CAOUT) != 0; // CCI1B = CAOUT
+            }
+            return (pinLevel[1] & pinB[timer][channel]) != 0;
+        case CCIS_2:
+            return 0;
+        default:
+            return 1;
+    }
+}
+
+static void outputEvent(struct timer *t, unsigned char channel) {
+    unsigned char mode = (*t->cctl[channel] >> 5) & 7, i;
+
+    switch (mode) {
+        case 1: case 3: t->out[channel] = 1; break;
+        case 5: case 7: t->out[channel] = 0; break;
+        case 2: case 4: case 6: t->out[channel] ^= 1; break;
+    }
+    if (channel == 0) {             // CCR0 part of the dual modes of CCR1/CCR2
+        for (i = 1; i < 3; i++) {
+            mode = (*t->cctl[i] >> 5) & 7;
+            if (mode == 2 || mode == 3) {
+                t->out[i] = 0;
+            } else if (mode == 6 || mode == 7) {
+                t->out[i] = 1;
+            }
+        }
+    }
+}
+
+static void timerClock(struct timer *t) {
+    unsigned int mode = *t->ctl & MC_3;
+    unsigned char i;
+
+    if ((*t->ctl >> 6 & 3) && ++t->prescale < (1u << (*t->ctl >> 6 & 3))) {
+        return;                     // ID divider
+    }
+    t->prescale = 0;
+    if (mode != MC_2 && *t->ccr[0] == 0) {
+        return;                     // Up mode with TACCR0 = 0 halts the timer
+    }
+    if (mode == MC_2) {
+        if (++*t->r == 0) {
+            *t->ctl |= TAIFG;
+        }
+    } else if (*t->r >= *t->ccr[0]) {
+        *t->r = 0;                  // Up mode, up/down mode is counted as up mode
+        *t->ctl |= TAIFG;
+    } else {
+        ++*t->r;
+    }
+    for (i = 0; i < 3; i++) {
+        if (!(*t->cctl[i] & CAP) && *t->r == *t->ccr[i]) {
+            *t->cctl[i] = (*t->cctl[i] & ~SCCI) | ((*t->cctl[i] & CCI) ? SCCI : 0) | CCIFG;
+            outputEvent(t, i);
+        }
+    }
+}
+
+static void timerStep(unsigned char n, unsigned char smclkTick, unsigned char aclkTick) {
+    struct timer *t = &timers[n];
+    unsigned char i, level, before[3];
+    unsigned int cctl, cm;
+
+    for (i = 0; i < 3; i++) {
+        before[i] = t->out[i];
+        cctl = *t->cctl[i];
+        level = captureInput(n, i, cctl);
+        if (level != t->cci[i]) {
+            cm = cctl & CM_3;
+            if ((cctl & CAP) && (cm == CM_3 || (cm == CM_1 && level) || (cm == CM_2 && !level))) {
+                if (cctl & CCIFG) {
+                    cctl |= COV;    // Previous capture not read
+                }
+                *t->ccr[i] = *t->r;
+                cctl |= CCIFG;
+            }
+            t->cci[i] = level;
+        }
+        *t->cctl[i] = (cctl & ~CCI) | (level ? CCI : 0);
+    }
+    if (*t->ctl & TACLR) {
+        *t->r = 0;
+        t->prescale = 0;
+        *t->ctl &= ~TACLR;
+    }
+    if (*t->ctl & MC_3) {
+        switch (*t->ctl & TASSEL_3) {
+            case TASSEL_0: if (n == 0 && taclkRise) timerClock(t); break;
+            case TASSEL_1: while (aclkTick--) timerClock(t); break;
+            case TASSEL_2: if (smclkTick) timerClock(t); break;
+            default: break;         // INCLK not connected
+        }
+    }
+    for (i = 0; i < 3; i++) {
+        if (((*t->cctl[i] >> 5) & 7) == 0) {
+            t->out[i] = (*t->cctl[i] & OUT) != 0;
+        }
+        t->outRise[i] = !before[i] && t->out[i];
+    }
+}
+
+// Vcc/2 against VREF+ (SREF_1: 1.5 V or 2.5 V with REF2_5V) or against Vcc itself
+static unsigned int adcVcc(unsigned int ctl0) {
+    unsigned long ref = (ctl0 & SREF_7) == SREF_1 ? ((ctl0 & REF2_5V) ? 2500 : 1500) : vccMv;
+    unsigned long code = vccMv / 2 * 1023UL / ref;
+
+    return code > 1023 ? 1023 : (unsigned int)code;
+}
+
+static void adcStep(void) {
+    static const unsigned char sht[4] = {4, 8, 16, 64};
+    unsigned int ctl0 = host_ADC10CTL0, ctl1 = host_ADC10CTL1;
+    static const unsigned char shsOutput[4] = {0, 1, 0, 2}; // SHS_1 OUT1, SHS_2 OUT0, SHS_3 OUT2
+    unsigned char trigger = 0, shs;
+    unsigned long long clock;
+
+    if (!(ctl0 & ADC10ON)) {
+        adcBusy = 0;
+        host_ADC10CTL1 &= ~ADC10BUSY;
+        return;
+    }
+    if (ctl0 & ENC) {
+        shs = (ctl1 >> 10) & 3;
+        trigger = shs == 0 ? (ctl0 & ADC10SC) != 0 : timers[0].outRise[shsOutput[shs]];
+    }
+    host_ADC10CTL0 &= ~ADC10SC;
+    if (trigger && !adcBusy) {
+        switch (ctl1 & ADC10SSEL_3) {
+            case ADC10SSEL_0: clock = PS_PER_S / 5000000; break; // ADC10OSC
+            case ADC10SSEL_1: clock = PS_PER_S / vloHz; break;
+            default: clock = dcoPeriod(); break;
+        }
+        adcDonePs = now + (sht[(ctl0 >> 11) & 3] + 13) * (((ctl1 >> 5) & 7) + 1) * clock;
+        adcBusy = 1;
+        host_ADC10CTL1 |= ADC10BUSY;
+    }
+    if (adcBusy && now >= adcDonePs) {
+        host_ADC10MEM = adcInput[ctl1 >> 12];
+        if ((ctl1 >> 12) == 11 && !(adcFixed & (1u << 11))) {
+            host_ADC10MEM = adcVcc(ctl0);
+        }
+        host_ADC10CTL0 |= ADC10IFG;
+        host_ADC10CTL1 &= ~ADC10BUSY;
+        adcBusy = 0;
+        adcConversions++;
+    }
+}
+
+static void wdtStep(unsigned char smclkTick, unsigned char aclkTick) {
+    static const unsigned long interval[4] = {32768, 8192, 512, 64};
+    unsigned int ctl = host_WDTCTL;
+
+    if ((ctl >> 8) == 0x5A) {       // Written with the password, read back as 0x69
+        ctl = 0x6900 | (ctl & 0xFF);
+    } else if ((ctl >> 8) != 0x69) {
+        printf("WDT password violation, PUC at %llu us\n", now / 1000000);
+        hostFinish(2);
+    }
+    if (ctl & WDTCNTCL) {
+        wdtCount = 0;
+        ctl &= ~WDTCNTCL;
+    }
+    host_WDTCTL = ctl;
+    if (ctl & WDTHOLD) {
+        return;
+    }
+    wdtCount += (ctl & WDTSSEL) ? aclkTick : smclkTick;
+    if (wdtCount >= interval[ctl & 3]) {
+        wdtCount = 0;
+        if (!(ctl & WDTTMSEL)) {
+            printf("Watchdog reset at %llu us\n", now / 1000000);
+            hostFinish(2);
+        }
+        host_IFG1 |= WDTIFG;
+    }
+}
+
+// UART decoder of the TX line, also measures the edge positions against the ideal bit grid
+static void txStep(void) {
+    unsigned char level = (pinLevel[txPort] & txMask) != 0;
+    unsigned long long bit = PS_PER_S / baud, k, dev;
+
+    if (!txBusy) {
+        if (txLast && !level) {
+            txBusy = 1;
+            txStart = now;
+            txBit = 0;
+            txData = 0;
+        }
+    } else {
+        if (level != txLast && now - txStart >= bit / 2) {
+            k = (now - txStart + bit / 2) / bit;
+            dev = now - txStart > k * bit ? now - txStart - k * bit : k * bit - (now - txStart);
+            if (dev > txMaxDev) {
+                txMaxDev = dev;
+            }
+        }
+        while (txBit < 10 && now >= txStart + txBit * bit + bit / 2) {
+            txData |= (unsigned int)level << txBit++;
+        }
+        if (txBit == 1 && (txData & 1)) {
+            txBusy = 0;             // Glitch, the start bit is checked in the middle like a real receiver
+        } else if (txBit == 10) {
+            txBusy = 0;
+            txFrames++;
+            if ((txData & 1) || !(txData & 0x200)) {
+                txErrors++;         // Start bit not 0 or stop bit not 1
+            } else if (txLength < TX_LOG_SIZE - 1) {
+                txLog[txLength++] = (char)(txData >> 1);
+            }
+        }
+    }
+    txLast = level;
+}
+
+// "stream": bytes 0x00, 0x01, .. back to back on the RX line, computed per step instead of queued as events
+static void streamStep(void) {
+    struct stream *st;
+    unsigned long long n;
+    unsigned int frameBits, frame;
+    unsigned char i;
+
+    for (i = 0; i < streamCount; i++) {
+        st = &streams[i];
+        if (!st->bytes || now < st->ps) {
+            continue;
+        }
+        frameBits = 9 + st->stop;
+        n = (now - st->ps) / st->bit;
+        if (n >= (unsigned long long)frameBits * st->bytes) {
+            extLevel[st->port] |= st->mask; // Stop bit level stays
+            st->bytes = 0;
+            continue;
+        }
+        frame = ((unsigned int)(unsigned char)(n / frameBits) << 1) | ~0x1FFu; // Start, 8 data, stop bits
+        extDriven[st->port] |= st->mask;
+        extLevel[st->port] = (frame >> (n % frameBits)) & 1 ? extLevel[st->port] | st->mask
+                                                             : extLevel[st->port] & ~st->mask;
+    }
+}
+
+static void memError(const char *text, unsigned char cmd) {
+    if (mem.errors++ < SPIMEM_REPORTED) {
+        printf("spimem: %s (command 0x%02X) at %llu us\n", text, cmd, now / 1000000);
+    }
+}
+
+// Chip select of the memory went high: a page program or erase starts, the write latch is reset
+static void memDeselect(void) {
+    unsigned int i;
+    unsigned long n = 0, base;
+
+    if (mem.cmd == MEM_PP && mem.count > 4) {
+        base = mem.addr & ~(unsigned long)(SPIMEM_PAGE - 1);
+        for (i = 0; i < SPIMEM_PAGE && mem.kind == MEMORY_FLASH; i++) {
+            if (!mem.latched[i]) {
+                continue;
+            }
+            if ((mem.data[base + i] & mem.latch[i]) != mem.latch[i]) {
+                memError("program over bits that are not erased", MEM_PP);
+            }
+            mem.data[base + i] &= mem.latch[i];
+            n++;
+        }
+        if (mem.kind == MEMORY_FRAM) {
+            n = mem.count - 4;
+        }
+        mem.programs++;
+        mem.programmed += n;
+        mem.busyPs = now + mem.programPs;
+        mem.wel = 0;
+    } else if (mem.cmd == MEM_SE && mem.count == 4) {
+        memset(mem.data + (mem.addr & ~(unsigned long)(SPIMEM_SECTOR - 1)), 0xFF, SPIMEM_SECTOR);
+        mem.erases++;
+        mem.busyPs = now + mem.erasePs;
+        mem.wel = 0;
+    } else if ((mem.cmd == MEM_PP || mem.cmd == MEM_SE || mem.cmd == MEM_READ) && mem.count < 4) {
+        memError("chip select raised inside the address", mem.cmd);
+    } else if (mem.cmd == MEM_WRSR) {
+        mem.wel = 0;
+    }
+}
+
+// One byte clocked with chip select low: MOSI in, returns MISO of the next byte
+static unsigned char memByte(unsigned char mosi) {
+    unsigned char busy = now < mem.busyPs;
+    unsigned int offset;
+
+    if (++mem.count == 1) {
+        mem.cmd = mosi;
+        if (busy && mosi != MEM_RDSR) {
+            memError("command while a program or erase is in progress", mosi);
+            mem.cmd = 0;
+            return 0xFF;
+        }
+        switch (mosi) {
+            case MEM_WREN: mem.wel = 1; break;
+            case MEM_WRDI: mem.wel = 0; break;
+            case MEM_RDSR: case MEM_READ: break;
+            case MEM_WRSR: case MEM_PP: case MEM_SE:
+                if (!mem.wel) {
+                    memError("write without WREN", mosi);
+                    mem.cmd = 0;
+                } else if (mosi == MEM_SE && mem.kind == MEMORY_FRAM) {
+                    memError("FRAM has no sector erase", mosi);
+                    mem.cmd = 0;
+                }
+                break;
+            default:
+                memError("unknown command", mosi);
+                mem.cmd = 0;
+                break;
+        }
+        mem.addr = 0;
+        memset(mem.latched, 0, sizeof(mem.latched));
+        return mem.cmd == MEM_RDSR ? (busy ? 1 : 0) | (mem.wel ? 2 : 0) : 0xFF;
+    }
+    switch (mem.cmd) {
+        case MEM_RDSR:
+            return (busy ? 1 : 0) | (mem.wel ? 2 : 0);
+        case MEM_READ:
+            if (mem.count < 4) {
+                mem.addr = mem.addr << 8 | mosi;
+                return 0xFF;
+            }
+            if (mem.count == 4) {
+                mem.addr = (mem.addr << 8 | mosi) % SPIMEM_SIZE;
+            } else {
+                mem.read++;
+            }
+            mem.miso = mem.data[mem.addr];
+            mem.addr = (mem.addr + 1) % SPIMEM_SIZE;
+            return mem.miso;
+        case MEM_PP: case MEM_SE:
+            if (mem.count <= 4) {
+                mem.addr = (mem.addr << 8 | mosi) % SPIMEM_SIZE;
+                return 0xFF;
+            }
+            if (mem.kind == MEMORY_FRAM) {
+                mem.data[mem.addr] = mosi;
+                mem.addr = (mem.addr + 1) % SPIMEM_SIZE;
+                return 0xFF;
+            }
+            offset = (mem.addr + mem.count - 5) % SPIMEM_PAGE; // Wraps inside the page like the device
+            if (mem.count - 5 == SPIMEM_PAGE - mem.addr % SPIMEM_PAGE) {
+                memError("page program crosses the page end", MEM_PP);
+            }
+            mem.latch[offset] = mosi;
+            mem.latched[offset] = 1;
+            return 0xFF;
+    }
+    return 0xFF;
+}
+
+// USCI_B0 in 3-pin SPI master mode, the memory sees the bytes when the pins are selected and CS is low
+static void usciStep(unsigned char smclkTick, unsigned char aclkTick) {
+    unsigned char ctl0 = host_UCB0CTL0, ctl1 = host_UCB0CTL1, selected, tick, mode;
+    const unsigned char pins = BIT5 + BIT6 + BIT7;
+    unsigned long div = host_UCB0BR0 | (unsigned long)host_UCB0BR1 << 8;
+
+    if (mem.kind) {
+        selected = !(pinLevel[mem.port] & mem.cs);
+        if (selected && !mem.selected) {
+            mem.count = 0;
+            mem.cmd = 0;
+            mem.miso = 0xFF;
+        } else if (!selected && mem.selected) {
+            memDeselect();
+        }
+        mem.selected = selected;
+    }
+    if (ctl1 & UCSWRST) {           // Reset: flags and enables cleared, TXIFG set
+        usciTxWritten = usciTxFull = usciShifting = 0;
+        host_IFG2 = (host_IFG2 & ~UCB0RXIFG) | UCB0TXIFG;
+        host_IE2 &= ~(UCB0RXIE | UCB0TXIE);
+        host_UCB0STAT &= ~(UCBUSY | UCOE);
+        return;
+    }
+    if ((ctl0 & (UCMST | UCSYNC)) != (UCMST | UCSYNC)) {
+        return;                     // Slave, I2C and UART mode are not modeled
+    }
+    if (usciTxWritten) {
+        usciTxWritten = 0;
+        usciTxFull = 1;
+        host_IFG2 &= ~UCB0TXIFG;
+    }
+    if (!usciShifting && usciTxFull) {
+        usciShift = host_UCB0TXBUF;
+        usciTxFull = 0;
+        usciShifting = 1;
+        usciLeft = 8 * (div ? div : 1);
+        host_IFG2 |= UCB0TXIFG;
+    }
+    switch (ctl1 & UCSSEL_3) {
+        case UCSSEL_1: tick = aclkTick; break;
+        case UCSSEL_0: tick = 0; break; // UCLK input not connected
+        default: tick = smclkTick; break;
+    }
+    if (usciShifting && tick) {
+        usciLeft -= tick < usciLeft ? tick : usciLeft;
+        if (!usciLeft) {
+            host_UCB0RXBUF = 0xFF;  // MISO pulled up
+            if (mem.kind && mem.selected && (host_P1SEL & host_P1SEL2 & pins) == pins) {
+                mode = ctl0 & (UCCKPH | UCCKPL | UCMSB | UC7BIT | UCMODE_3);
+                if (mode != (UCCKPH | UCMSB) && mode != (UCCKPL | UCMSB)) {
+                    memError("byte not in SPI mode 0 or 3, MSB first, 8 bit, 3-pin", usciShift);
+                }
+                host_UCB0RXBUF = mem.miso;
+                mem.miso = memByte(usciShift);
+            }
+            if (host_IFG2 & UCB0RXIFG) {
+                host_UCB0STAT |= UCOE;
+            }
+            host_IFG2 |= UCB0RXIFG;
+            usciShifting = 0;
+            if (usciTxFull) {       // Next byte follows without a gap
+                usciShift = host_UCB0TXBUF;
+                usciTxFull = 0;
+                usciShifting = 1;
+                usciLeft = 8 * (div ? div : 1);
+                host_IFG2 |= UCB0TXIFG;
+            }
+        }
+    }
+    host_UCB0STAT = (host_UCB0STAT & ~UCBUSY) | (usciShifting || usciTxFull ? UCBUSY : 0);
+}
+
+static void applyEvents(void) {
+    struct event *e;
+
+    while (nextEvent < eventCount && events[nextEvent].ps <= now) {
+        e = &events[nextEvent++];
+        switch (e->kind) {
+            case EV_PIN:
+                extDriven[e->port] |= e->mask;
+                extLevel[e->port] = e->value ? extLevel[e->port] | e->mask : extLevel[e->port] & ~e->mask;
+                break;
+            case EV_RELEASE:
+                extDriven[e->port] &= ~e->mask;
+                break;
+            case EV_ADC:
+                adcInput[e->mask & 15] = e->value;
+                break;
+            case EV_VLO:
+                vloHz = e->value;
+                break;
+            case EV_VCC:
+                vccMv = e->value;
+                if (vccMv < vccMin) {
+                    vccMin = vccMv;
+                }
+                break;
+        }
+    }
+}
+
+// One DCO cycle of the peripherals
+static void hostStep(void) {
+    unsigned long long period = dcoPeriod();
+    unsigned char smclkTick = 0, aclkTick = 0;
+    unsigned long long half;
+    unsigned long aclkHz = (host_BCSCTL3 & LFXT1S_3) == LFXT1S_2 ? vloHz : 32768;
+
+    now += period;
+    cycles++;
+    if (!(hostSR & CPUOFF)) {
+        activePs += period;
+    }
+    applyEvents();
+    streamStep();
+    if (PS_PER_S / period > ratedHz(vccMv)) {
+        if (!overclockPs) {
+            overclockFirst = now;
+        }
+        overclockPs += period;
+    }
+
+    if (!(hostSR & SCG1) && ++smclkDiv >= 1u << ((host_BCSCTL2 >> 1) & 3)) {
+        smclkDiv = 0;
+        smclkTick = 1;
+    }
+    if (!(hostSR & OSCOFF)) {
+        half = PS_PER_S / (2 * aclkHz);
+        aclkAcc += period;
+        while (aclkAcc >= half) {   // ACLK level toggles every DIVA half periods of the oscillator
+            aclkAcc -= half;
+            if (++aclkDiv >= 1u << ((host_BCSCTL1 >> 4) & 3)) {
+                aclkDiv = 0;
+                aclkLevel ^= 1;
+                aclkTick += aclkLevel;
+            }
+        }
+    }
+
+    portStep();
+    timerStep(0, smclkTick, aclkTick);
+    timerStep(1, smclkTick, aclkTick);
+    adcStep();
+    wdtStep(smclkTick, aclkTick);
+    txStep();
+    usciStep(smclkTick, aclkTick);
+
+    if (now >= endPs) {
+        hostFinish(0);
+    }
+    if (cycles == WRAP_CYCLES) {
+        printf("2^32 cycles at %llu us, 32-bit time stamps would wrap on the MSP430 but not on the host\n",
+               now / 1000000);
+        hostFinish(2);
+    }
+}
+
+static int pendingVector(void) {
+    int v;
+
+    for (v = 0; v < VECTORS; v++) {
+        switch (v) {
+            case VEC_TIMER1_A0: if ((host_TA1CCTL0 & (CCIE | CCIFG)) == (CCIE | CCIFG)) return v; break;
+            case VEC_TIMER0_A0: if ((host_TA0CCTL0 & (CCIE | CCIFG)) == (CCIE | CCIFG)) return v; break;
+            case VEC_TIMER1_A1:
+                if ((host_TA1CCTL1 & (CCIE | CCIFG)) == (CCIE | CCIFG) ||
+                    (host_TA1CCTL2 & (CCIE | CCIFG)) == (CCIE | CCIFG) ||
+                    (host_TA1CTL & (TAIE | TAIFG)) == (TAIE | TAIFG)) return v;
+                break;
+            case VEC_TIMER0_A1:
+                if ((host_TA0CCTL1 & (CCIE | CCIFG)) == (CCIE | CCIFG) ||
+                    (host_TA0CCTL2 & (CCIE | CCIFG)) == (CCIE | CCIFG) ||
+                    (host_TA0CTL & (TAIE | TAIFG)) == (TAIE | TAIFG)) return v;
+                break;
+            case VEC_COMPARATORA: if ((host_CACTL1 & (CAIE | CAIFG)) == (CAIE | CAIFG)) return v; break;
+            case VEC_WDT: if ((host_IE1 & WDTIE) && (host_IFG1 & WDTIFG)) return v; break;
+            case VEC_USCIAB0RX: if (host_IE2 & host_IFG2 & (UCA0RXIFG | UCB0RXIFG)) return v; break;
+            case VEC_USCIAB0TX: if (host_IE2 & host_IFG2 & (UCA0TXIFG | UCB0TXIFG)) return v; break;
+            case VEC_ADC10: if ((host_ADC10CTL0 & (ADC10IE | ADC10IFG)) == (ADC10IE | ADC10IFG)) return v; break;
+            case VEC_PORT2: if (host_P2IE & host_P2IFG) return v; break;
+            case VEC_PORT1: if (host_P1IE & host_P1IFG) return v; break;
+        }
+    }
+    return -1;
+}
+
+static void dispatch(int v) {
+    unsigned char i;
+
+    if (isrDepth == SR_STACK) {
+        printf("Interrupts nested deeper than %d at %llu us\n", SR_STACK, now / 1000000);
+        hostFinish(2);
+    }
+    if (!vectors[v].handler) {
+        printf("%s pending without a handler at %llu us\n", vectors[v].name, now / 1000000);
+        hostFinish(2);
+    }
+    switch (v) {                    // Single source flags are reset when the interrupt is accepted
+        case VEC_TIMER0_A0: host_TA0CCTL0 &= ~CCIFG; break;
+        case VEC_TIMER1_A0: host_TA1CCTL0 &= ~CCIFG; break;
+        case VEC_ADC10: host_ADC10CTL0 &= ~ADC10IFG; break;
+        case VEC_WDT: host_IFG1 &= ~WDTIFG; break;
+        case VEC_COMPARATORA: host_CACTL1 &= ~CAIFG; break;
+    }
+    vectors[v].count++;
+    savedSR[isrDepth++] = hostSR;
+    hostSR &= SCG0;
+    for (i = 0; i < 6; i++) {
+        hostStep();
+    }
+    vectors[v].handler();
+    for (i = 0; i < 5; i++) {
+        hostStep();
+    }
+    hostSR = savedSR[--isrDepth];
+}
+
+void hostCycles(unsigned long n) {
+    int v;
+
+    modelDepth++;
+    while (n--) {
+        hostStep();
+        if ((hostSR & GIE) && (v = pendingVector()) >= 0) {
+            dispatch(v);
+        }
+    }
+    modelDepth--;
+}
+
+volatile unsigned char *hostReg8(volatile unsigned char *reg) {
+    hostCycles(HOST_ACCESS_CYCLES);
+    return reg;
+}
+
+volatile unsigned short *hostReg16(volatile unsigned short *reg) {
+    hostCycles(HOST_ACCESS_CYCLES);
+    return reg;
+}
+
+volatile unsigned char *hostPortIn(unsigned char port) {
+    hostCycles(HOST_ACCESS_CYCLES);
+    return port == 1 ? &host_P1IN : &host_P2IN;
+}
+
+// TAIV: highest pending enabled flag, reading clears it
+volatile unsigned short *hostTimerIV(unsigned char n) {
+    struct timer *t = &timers[n];
+
+    hostCycles(HOST_ACCESS_CYCLES);
+    if ((*t->cctl[1] & (CCIE | CCIFG)) == (CCIE | CCIFG)) {
+        *t->cctl[1] &= ~CCIFG;
+        *t->iv = 2;
+    } else if ((*t->cctl[2] & (CCIE | CCIFG)) == (CCIE | CCIFG)) {
+        *t->cctl[2] &= ~CCIFG;
+        *t->iv = 4;
+    } else if ((*t->ctl & (TAIE | TAIFG)) == (TAIE | TAIFG)) {
+        *t->ctl &= ~TAIFG;
+        *t->iv = 10;
+    } else {
+        *t->iv = 0;
+    }
+    return t->iv;
+}
+
+// UCB0TXBUF (rx 0): the byte is taken at the next step; UCB0RXBUF (rx 1): reading clears UCB0RXIFG and UCOE
+volatile unsigned char *hostUsciB0Buf(unsigned char rx) {
+    hostCycles(HOST_ACCESS_CYCLES);
+    if (rx) {
+        host_IFG2 &= ~UCB0RXIFG;
+        host_UCB0STAT &= ~UCOE;
+        return &host_UCB0RXBUF;
+    }
+    usciTxWritten = 1;
+    return &host_UCB0TXBUF;
+}
+
+void hostBisSR(unsigned short bits) {
+    hostSR |= bits;
+    if (hostSR & CPUOFF) {
+        while (hostSR & CPUOFF) {   // Only an interrupt returning with cleared LPM bits ends this
+            hostCycles(1);
+        }
+        wakeups++;
+    } else {
+        hostCycles(1);
+    }
+}
+
+void hostBicSR(unsigned short bits) {
+    hostSR &= ~bits;
+    hostCycles(1);
+}
+
+void hostBisSROnExit(unsigned short bits) {
+    if (isrDepth) {
+        savedSR[isrDepth - 1] |= bits;
+    }
+}
+
+void hostBicSROnExit(unsigned short bits) {
+    if (isrDepth) {
+        savedSR[isrDepth - 1] &= ~bits;
+    }
+}
+
+// The program spins on a RAM variable: no register access since the last tick, let time pass
+static void stallTick(int signal) {
+    (void)signal;
+    if (modelDepth == 0 && cycles == stallMark) {
+        hostCycles(STALL_CYCLES);
+    }
+    stallMark = cycles;
+}
+
+static void printEscaped(const char *text, unsigned int length) {
+    unsigned int i;
+
+    for (i = 0; i < length; i++) {
+        if (text[i] == '\r') {
+            printf("\\r");
+        } else if (text[i] == '\n') {
+            printf("\\n");
+        } else if (text[i] < ' ' || text[i] > '~') {
+            printf("\\x%02X", (unsigned char)text[i]);
+        } else {
+            putchar(text[i]);
+        }
+    }
+}
+
+static int checkExpect(struct expect *e) {
+    unsigned long value;
+    unsigned int length, i;
+
+    switch (e->kind) {
+        case EXPECT_TX:             // The log may hold 0x00 bytes, no strstr()
+            length = strlen(e->text);
+            printf("expect-tx \"");
+            printEscaped(e->text, length);
+            printf("\"");
+            for (i = 0; i + length <= txLength; i++) {
+                if (!memcmp(txLog + i, e->text, length)) {
+                    return 1;
+                }
+            }
+            return 0;
+        case EXPECT_WAKEUPS:
+            value = wakeups;
+            printf("expect-wakeups %lu..%lu: %lu", e->min, e->max, value);
+            break;
+        case EXPECT_ISR:
+            value = vectors[e->vector].count;
+            printf("expect-isr %s %lu..%lu: %lu", vectors[e->vector].name, e->min, e->max, value);
+            break;
+        case EXPECT_SPIMEM:
+            value = mem.programmed;
+            printf("expect-spimem %lu..%lu: %lu", e->min, e->max, value);
+            break;
+        default:
+            value = (unsigned long)(txMaxDev * 100 / (PS_PER_S / baud));
+            printf("expect-bit-error <= %lu %%: %lu %%", e->max, value);
+            break;
+    }
+    return value >= e->min && value <= e->max;
+}
+
+static void hostFinish(int status) {
+    unsigned int i;
+    int v;
+
+    printf("time %llu us, %llu cycles, CPU active %.2f %%, wakeups %lu, ADC10 conversions %lu\n",
+           now / 1000000, cycles, now ? 100.0 * activePs / now : 0.0, wakeups, adcConversions);
+    printf("isr");
+    for (v = 0; v < VECTORS; v++) {
+        if (vectors[v].count) {
+            printf(" %s %lu", vectors[v].name, vectors[v].count);
+        }
+    }
+    printf("\ntx \"");
+    if (txLength > TX_PRINT) {
+        printf("[%u bytes] ", txLength - TX_PRINT);
+        printEscaped(txLog + txLength - TX_PRINT, TX_PRINT);
+    } else {
+        printEscaped(txLog, txLength);
+    }
+    printf("\"\ntx frames %lu, framing errors %lu, worst edge %.2f us (%.1f %% of a bit at %lu baud)\n",
+           txFrames, txErrors, txMaxDev / 1e6, 100.0 * txMaxDev / (PS_PER_S / baud), baud);
+    if (vccScripted || overclockPs) {
+        printf("vcc min %u mV, DCO above the rated frequency %llu us", vccMin, overclockPs / 1000000);
+        if (overclockPs) {
+            printf(" from %llu us FAIL\n", overclockFirst / 1000000);
+            if (status == 0) {
+                status = 1;
+            }
+        } else {
+            printf(" PASS\n");
+        }
+    }
+    if (mem.kind) {
+        printf("spimem %s: %lu programs, %lu bytes programmed, %lu sector erases, %lu bytes read, %lu errors",
+               mem.kind == MEMORY_FLASH ? "flash" : "fram", mem.programs, mem.programmed, mem.erases, mem.read,
+               mem.errors);
+        if (mem.errors) {
+            printf(" FAIL\n");
+            if (status == 0) {
+                status = 1;
+            }
+        } else {
+            printf(" PASS\n");
+        }
+    }
+    for (i = 0; i < expectCount; i++) {
+        if (checkExpect(&expects[i])) {
+            printf(" PASS\n");
+        } else {
+            printf(" FAIL\n");
+            if (status == 0) {
+                status = 1;
+            }
+        }
+    }
+    fflush(stdout);
+    exit(status);
+}
+
+static void addEvent(unsigned long long ps, unsigned char kind, unsigned char port, unsigned char mask,
+                     unsigned int value) {
+    if (eventCount == MAX_EVENTS) {
+        fprintf(stderr, "more than %d events\n", MAX_EVENTS);
+        exit(2);
+    }
+    events[eventCount].ps = ps;
+    events[eventCount].order = eventCount;
+    events[eventCount].kind = kind;
+    events[eventCount].port = port;
+    events[eventCount].mask = mask;
+    events[eventCount].value = value;
+    eventCount++;
+}
+
+static int eventOrder(const void *a, const void *b) {
+    const struct event *x = a, *y = b;
+
+    if (x->ps != y->ps) {
+        return x->ps < y->ps ? -1 : 1;
+    }
+    return x->order < y->order ? -1 : 1;
+}
+
+// "1.2" -> port index 0, mask BIT2
+static int parsePin(const char *s, unsigned char *port, unsigned char *mask) {
+    if ((s[0] != '1' && s[0] != '2') || s[1] != '.' || s[2] < '0' || s[2] > '7' || s[3]) {
+        return 0;
+    }
+    *port = s[0] - '1';
+    *mask = 1 << (s[2] - '0');
+    return 1;
+}
+
+// Quoted string with \r \n \\ \" \xHH, returns its length or -1
+static int parseString(const char *s, char *out, unsigned int size) {
+    unsigned int n = 0;
+    unsigned int hex;
+
+    if (*s++ != '"') {
+        return -1;
+    }
+    while (*s && *s != '"' && n < size - 1) {
+        if (*s == '\\') {
+            s++;
+            switch (*s) {
+                case 'r': out[n++] = '\r'; break;
+                case 'n': out[n++] = '\n'; break;
+                case 'x':
+                    if (sscanf(s + 1, "%2x", &hex) != 1) return -1;
+                    out[n++] = (char)hex;
+                    s += 2;
+                    break;
+                default: out[n++] = *s; break;
+            }
+            s++;
+        } else {
+            out[n++] = *s++;
+        }
+    }
+    if (*s != '"') {
+        return -1;
+    }
+    out[n] = '\0';
+    return n;
+}
+
+static int findVector(const char *name) {
+    int v;
+
+    for (v = 0; v < VECTORS; v++) {
+        if (!strcmp(vectors[v].name, name)) {
+            return v;
+        }
+    }
+    return -1;
+}
+
+static void scriptError(const char *file, unsigned int line, const char *text) {
+    fprintf(stderr, "%s:%u: %s", file, line, text);
+    exit(2);
+}
+
+static void loadScript(const char *file) {
+    FILE *f = fopen(file, "r");
+    char text[256], word[32], arg[32], string[128], *rest;
+    unsigned int line = 0, i, pos;
+    unsigned long long us, ps, bit;
+    unsigned long a, b;
+    unsigned char port, mask;
+    int length;
+    struct expect *e;
+
+    if (!f) {
+        perror(file);
+        exit(2);
+    }
+    while (fgets(text, sizeof(text), f)) {
+        line++;
+        if ((rest = strchr(text, '#')) && !strchr(text, '"')) {
+            *rest = '\0';
+        }
+        if (sscanf(text, "%31s", word) != 1) {
+            continue;
+        }
+        if (word[0] >= '0' && word[0] <= '9') {     // Timed stimulus: <us> <command> ...
+            us = strtoull(word, NULL, 10);
+            ps = us * 1000000;
+            if (sscanf(text, "%*s %31s%n", word, &pos) != 1) scriptError(file, line, text);
+            rest = text + pos;
+            while (*rest == ' ' || *rest == '\t') rest++;
+            if (!strcmp(word, "send")) {
+                if ((length = parseString(rest, string, sizeof(string))) < 0) scriptError(file, line, text);
+                bit = PS_PER_S / baud;
+                for (i = 0; i < (unsigned int)length; i++) { // Start, 8 data LSB first, stop
+                    unsigned int frame = ((unsigned char)string[i] | 0x100) << 1;
+                    unsigned int k;
+                    for (k = 0; k < 10; k++) {
+                        addEvent(ps + k * bit, EV_PIN, rxPort, rxMask, (frame >> k) & 1);
+                    }
+                    ps += 10 * bit;
+                }
+            } else if (!strcmp(word, "stream")) {
+                b = 1;
+                if (sscanf(rest, "%lu %lu", &a, &b) < 1 || !a || !b || b > 2 || streamCount == STREAMS)
+                    scriptError(file, line, text);
+                streams[streamCount].ps = ps;       // On the rx line and at the baud rate set before
+                streams[streamCount].bit = PS_PER_S / baud;
+                streams[streamCount].bytes = a;
+                streams[streamCount].stop = (unsigned char)b;
+                streams[streamCount].port = rxPort;
+                streams[streamCount++].mask = rxMask;
+            } else if (!strcmp(word, "pin")) {
+                if (sscanf(rest, "%31s %lu", arg, &a) != 2 || !parsePin(arg, &port, &mask))
+                    scriptError(file, line, text);
+                addEvent(ps, EV_PIN, port, mask, a != 0);
+            } else if (!strcmp(word, "release")) {
+                if (sscanf(rest, "%31s", arg) != 1 || !parsePin(arg, &port, &mask)) scriptError(file, line, text);
+                addEvent(ps, EV_RELEASE, port, mask, 0);
+            } else if (!strcmp(word, "adc")) {
+                if (sscanf(rest, "%lu %lu", &a, &b) != 2 || a > 15) scriptError(file, line, text);
+                addEvent(ps, EV_ADC, 0, (unsigned char)a, (unsigned int)b);
+                adcFixed |= 1u << a;
+            } else if (!strcmp(word, "vcc")) {
+                if (sscanf(rest, "%lu", &a) != 1 || a < 1000 || a > 3600) scriptError(file, line, text);
+                addEvent(ps, EV_VCC, 0, 0, (unsigned int)a);
+                vccScripted = 1;
+            } else if (!strcmp(word, "vlo")) {
+                if (sscanf(rest, "%lu", &a) != 1 || !a) scriptError(file, line, text);
+                addEvent(ps, EV_VLO, 0, 0, (unsigned int)a);
+            } else {
+                scriptError(file, line, text);
+            }
+            continue;
+        }
+        rest = text + strlen(word);
+        while (*rest == ' ' || *rest == '\t') rest++;
+        if (!strcmp(word, "end")) {
+            if (sscanf(rest, "%llu", &us) != 1) scriptError(file, line, text);
+            endPs = us * 1000000;
+        } else if (!strcmp(word, "baud")) {
+            if (sscanf(rest, "%lu", &baud) != 1 || !baud) scriptError(file, line, text);
+        } else if (!strcmp(word, "tx")) {
+            if (sscanf(rest, "%31s", arg) != 1 || !parsePin(arg, &txPort, &txMask)) scriptError(file, line, text);
+        } else if (!strcmp(word, "rx")) {
+            if (sscanf(rest, "%31s", arg) != 1 || !parsePin(arg, &rxPort, &rxMask)) scriptError(file, line, text);
+        } else if (!strcmp(word, "spimem")) {
+            a = 800;                // Page program and 4 KB sector erase of a 25-series flash, typical
+            b = 45000;
+            if (sscanf(rest, "%31s %31s %lu %lu", string, arg, &a, &b) < 2 || !parsePin(arg, &mem.port, &mem.cs))
+                scriptError(file, line, text);
+            if (!strcmp(string, "flash")) {
+                mem.kind = MEMORY_FLASH;
+            } else if (!strcmp(string, "fram")) {
+                mem.kind = MEMORY_FRAM;
+                a = b = 0;
+            } else {
+                scriptError(file, line, text);
+            }
+            mem.programPs = a * 1000000ULL;
+            mem.erasePs = b * 1000000ULL;
+            if (!(mem.data = malloc(SPIMEM_SIZE))) {
+                perror("spimem");
+                exit(2);
+            }
+            memset(mem.data, 0xFF, SPIMEM_SIZE); // Delivered erased
+        } else if (!strncmp(word, "expect-", 7)) {
+            if (expectCount == MAX_EXPECT) scriptError(file, line, "too many expectations\n");
+            e = &expects[expectCount++];
+            e->min = 0;
+            e->max = ~0UL;
+            if (!strcmp(word, "expect-tx")) {
+                e->kind = EXPECT_TX;
+                if (parseString(rest, e->text, sizeof(e->text)) < 0) scriptError(file, line, text);
+            } else if (!strcmp(word, "expect-wakeups")) {
+                e->kind = EXPECT_WAKEUPS;
+                if (sscanf(rest, "%lu %lu", &e->min, &e->max) != 2) scriptError(file, line, text);
+            } else if (!strcmp(word, "expect-isr")) {
+                e->kind = EXPECT_ISR;
+                if (sscanf(rest, "%31s %lu %lu", arg, &e->min, &e->max) != 3 || (e->vector = findVector(arg)) < 0)
+                    scriptError(file, line, text);
+            } else if (!strcmp(word, "expect-spimem")) {
+                e->kind = EXPECT_SPIMEM;
+                if (sscanf(rest, "%lu %lu", &e->min, &e->max) != 2) scriptError(file, line, text);
+            } else if (!strcmp(word, "expect-bit-error")) {
+                e->kind = EXPECT_BIT_ERROR;
+                if (sscanf(rest, "%lu", &e->max) != 1) scriptError(file, line, text);
+            } else {
+                scriptError(file, line, text);
+            }
+        } else {
+            scriptError(file, line, text);
+        }
+    }
+    fclose(f);
+    qsort(events, eventCount, sizeof(events[0]), eventOrder);
+}
+
+int main(int argc, char **argv) {
+    struct itimerval tick = {{0, 1000}, {0, 1000}};
+
+    if (argc > 2) {
+        fprintf(stderr, "usage: %s [script]\n", argv[0]);
+        return 2;
+    }
+    if (argc == 2) {
+        loadScript(argv[1]);
+    }
+    host_WDTCTL = 0x6900;           // Reset values
+    host_BCSCTL1 = 0x87;
+    host_DCOCTL = 0x60;
+    host_P1IN = pinLevel[0] = 0xFF;
+    host_P2IN = pinLevel[1] = 0xFF;
+    host_P2SEL = BIT6 + BIT7;       // XIN/XOUT
+    host_UCB0CTL1 = UCSWRST;
+    host_IFG2 = UCB0TXIFG;
+    signal(SIGVTALRM, stallTick);
+    setitimer(ITIMER_VIRTUAL, &tick, NULL);
+
+    hostAppMain();
+    printf("main() returned\n");
+    hostFinish(0);
+    return 0;
+}
@@ -0,0 +1,509 @@
+/*
+ * msp430.h
+ *
+ * Host replacement of the TI device header, see README.md.
+ * Every register is a variable of the model (host_<name>); the register name is a macro that lets the model run
+ * HOST_ACCESS_CYCLES cycles before the access, so polling loops like while (ADC10CTL1 & ADC10BUSY) see time pass
+ * and interrupts are served between two accesses like between two instructions.
+ * The bit definitions are the ones of msp430g2553.h. 16-bit registers are unsigned short: the header is also
+ * compiled without the int = short of the programs (model.c), both sides must see the same types.
+ */
+
+#ifndef HOST_MSP430_H
+#define HOST_MSP430_H
+
+#ifndef HOST_ACCESS_CYCLES
+#define HOST_ACCESS_CYCLES 3    // MCLK cycles per register access, a MOV/BIS with one memory operand
+#endif
+
+// Registers of the model, 8 and 16 bit
+#define HOST_REGISTERS8 X(P1IN) X(P1OUT) X(P1DIR) X(P1IFG) X(P1IES) X(P1IE) X(P1SEL) X(P1SEL2) X(P1REN) \
+    X(P2IN) X(P2OUT) X(P2DIR) X(P2IFG) X(P2IES) X(P2IE) X(P2SEL) X(P2SEL2) X(P2REN) X(BCSCTL1) X(BCSCTL2) \
+    X(BCSCTL3) X(DCOCTL) X(IE1) X(IFG1) X(IE2) X(IFG2) X(CACTL1) X(CACTL2) X(CAPD) X(ADC10AE0) X(ADC10DTC0) \
+    X(ADC10DTC1) X(UCB0CTL0) X(UCB0CTL1) X(UCB0BR0) X(UCB0BR1) X(UCB0STAT) X(UCB0RXBUF) X(UCB0TXBUF)
+
+#define HOST_REGISTERS16 X(WDTCTL) X(FCTL1) X(FCTL2) X(FCTL3) X(TA0CTL) X(TA0R) X(TA0CCTL0) X(TA0CCTL1) \
+    X(TA0CCTL2) X(TA0CCR0) X(TA0CCR1) X(TA0CCR2) X(TA0IV) X(TA1CTL) X(TA1R) X(TA1CCTL0) X(TA1CCTL1) \
+    X(TA1CCTL2) X(TA1CCR0) X(TA1CCR1) X(TA1CCR2) X(TA1IV) X(ADC10CTL0) X(ADC10CTL1) X(ADC10MEM) X(ADC10SA)
+
+#define X(r) extern volatile unsigned char host_##r;
+HOST_REGISTERS8
+#undef X
+#define X(r) extern volatile unsigned short host_##r;
+HOST_REGISTERS16
+#undef X
+
+extern unsigned short hostSR;
+
+volatile unsigned char *hostReg8(volatile unsigned char *reg);
+volatile unsigned short *hostReg16(volatile unsigned short *reg);
+volatile unsigned char *hostPortIn(unsigned char port);
+volatile unsigned short *hostTimerIV(unsigned char timer);
+volatile unsigned char *hostUsciB0Buf(unsigned char rx);
+void hostCycles(unsigned long cycles);
+void hostBisSR(unsigned short bits);
+void hostBicSR(unsigned short bits);
+void hostBisSROnExit(unsigned short bits);
+void hostBicSROnExit(unsigned short bits);
+
+// Access through a pointer taken with &TA0CCR0 etc., counted like the named register (driver/uart.c)
+#define REG8(p)    (*hostReg8(p))
+#define REG16(p)   (*hostReg16(p))
+
+#define P1IN       (*hostPortIn(1))
+#define P1OUT      (*hostReg8(&host_P1OUT))
+#define P1DIR      (*hostReg8(&host_P1DIR))
+#define P1IFG      (*hostReg8(&host_P1IFG))
+#define P1IES      (*hostReg8(&host_P1IES))
+#define P1IE       (*hostReg8(&host_P1IE))
+#define P1SEL      (*hostReg8(&host_P1SEL))
+#define P1SEL2     (*hostReg8(&host_P1SEL2))
+#define P1REN      (*hostReg8(&host_P1REN))
+#define P2IN       (*hostPortIn(2))
+#define P2OUT      (*hostReg8(&host_P2OUT))
+#define P2DIR      (*hostReg8(&host_P2DIR))
+#define P2IFG      (*hostReg8(&host_P2IFG))
+#define P2IES      (*hostReg8(&host_P2IES))
+#define P2IE       (*hostReg8(&host_P2IE))
+#define P2SEL      (*hostReg8(&host_P2SEL))
+#define P2SEL2     (*hostReg8(&host_P2SEL2))
+#define P2REN      (*hostReg8(&host_P2REN))
+#define BCSCTL1    (*hostReg8(&host_BCSCTL1))
+#define BCSCTL2    (*hostReg8(&host_BCSCTL2))
+#define BCSCTL3    (*hostReg8(&host_BCSCTL3))
+#define DCOCTL     (*hostReg8(&host_DCOCTL))
+#define IE1        (*hostReg8(&host_IE1))
+#define IFG1       (*hostReg8(&host_IFG1))
+#define IE2        (*hostReg8(&host_IE2))
+#define IFG2       (*hostReg8(&host_IFG2))
+#define CACTL1     (*hostReg8(&host_CACTL1))
+#define CACTL2     (*hostReg8(&host_CACTL2))
+#define CAPD       (*hostReg8(&host_CAPD))
+#define ADC10AE0   (*hostReg8(&host_ADC10AE0))
+#define ADC10DTC0  (*hostReg8(&host_ADC10DTC0))
+#define ADC10DTC1  (*hostReg8(&host_ADC10DTC1))
+#define UCB0CTL0   (*hostReg8(&host_UCB0CTL0))
+#define UCB0CTL1   (*hostReg8(&host_UCB0CTL1))
+#define UCB0BR0    (*hostReg8(&host_UCB0BR0))
+#define UCB0BR1    (*hostReg8(&host_UCB0BR1))
+#define UCB0STAT   (*hostReg8(&host_UCB0STAT))
+#define UCB0RXBUF  (*hostUsciB0Buf(1))
+#define UCB0TXBUF  (*hostUsciB0Buf(0))
+#define WDTCTL     (*hostReg16(&host_WDTCTL))
+#define FCTL1      (*hostReg16(&host_FCTL1))
+#define FCTL2      (*hostReg16(&host_FCTL2))
+#define FCTL3      (*hostReg16(&host_FCTL3))
+#define TA0CTL     (*hostReg16(&host_TA0CTL))
+#define TA0R       (*hostReg16(&host_TA0R))
+#define TA0CCTL0   (*hostReg16(&host_TA0CCTL0))
+#define TA0CCTL1   (*hostReg16(&host_TA0CCTL1))
+#define TA0CCTL2   (*hostReg16(&host_TA0CCTL2))
+#define TA0CCR0    (*hostReg16(&host_TA0CCR0))
+#define TA0CCR1    (*hostReg16(&host_TA0CCR1))
+#define TA0CCR2    (*hostReg16(&host_TA0CCR2))
+#define TA0IV      (*hostTimerIV(0))
+#define TA1CTL     (*hostReg16(&host_TA1CTL))
+#define TA1R       (*hostReg16(&host_TA1R))
+#define TA1CCTL0   (*hostReg16(&host_TA1CCTL0))
+#define TA1CCTL1   (*hostReg16(&host_TA1CCTL1))
+#define TA1CCTL2   (*hostReg16(&host_TA1CCTL2))
+#define TA1CCR0    (*hostReg16(&host_TA1CCR0))
+#define TA1CCR1    (*hostReg16(&host_TA1CCR1))
+#define TA1CCR2    (*hostReg16(&host_TA1CCR2))
+#define TA1IV      (*hostTimerIV(1))
+#define ADC10CTL0  (*hostReg16(&host_ADC10CTL0))
+#define ADC10CTL1  (*hostReg16(&host_ADC10CTL1))
+#define ADC10MEM   (*hostReg16(&host_ADC10MEM))
+#define ADC10SA    (*hostReg16(&host_ADC10SA))
+
+#define TACTL TA0CTL
+#define TAR TA0R
+#define TACCTL0 TA0CCTL0
+#define TACCTL1 TA0CCTL1
+#define TACCTL2 TA0CCTL2
+#define TACCR0 TA0CCR0
+#define TACCR1 TA0CCR1
+#define TACCR2 TA0CCR2
+#define TAIV TA0IV
+
+// Calibration constants of INFOA, RSEL selects the DCO frequency of the model
+#define CALBC1_1MHZ 0x86
+#define CALDCO_1MHZ 0xB5
+#define CALBC1_8MHZ 0x8D
+#define CALDCO_8MHZ 0x92
+#define CALBC1_16MHZ 0x8F
+#define CALDCO_16MHZ 0x95
+
+// Intrinsics
+#define __interrupt
+#define HOST_VECTOR(v) __attribute__((section("hostvec_" #v), used)) // From #pragma vector = v, see hostcc.sh
+#define __even_in_range(x, y) (x)
+#define __delay_cycles(x) hostCycles(x)
+#define __no_operation() hostCycles(1)
+#define __bis_SR_register(x) hostBisSR(x)
+#define __bic_SR_register(x) hostBicSR(x)
+#define __bis_SR_register_on_exit(x) hostBisSROnExit(x)
+#define __bic_SR_register_on_exit(x) hostBicSROnExit(x)
+#define _BIS_SR(x) hostBisSR(x)
+#define _BIC_SR(x) hostBicSR(x)
+#define __enable_interrupt() hostBisSR(GIE)
+#define __disable_interrupt() hostBicSR(GIE)
+#define __get_SR_register() (hostSR)
+#define __get_SP_register() (0u)
+#define _get_SP_register() (0u)
+
+#define LPM0 hostBisSR(LPM0_bits)
+#define LPM1 hostBisSR(LPM1_bits)
+#define LPM2 hostBisSR(LPM2_bits)
+#define LPM3 hostBisSR(LPM3_bits)
+#define LPM4 hostBisSR(LPM4_bits)
+#define LPM0_EXIT hostBicSROnExit(LPM0_bits)
+#define LPM1_EXIT hostBicSROnExit(LPM1_bits)
+#define LPM2_EXIT hostBicSROnExit(LPM2_bits)
+#define LPM3_EXIT hostBicSROnExit(LPM3_bits)
+#define LPM4_EXIT hostBicSROnExit(LPM4_bits)
+
+// Interrupt vectors
+#define TRAPINT_VECTOR 0
+#define PORT1_VECTOR 2
+#define PORT2_VECTOR 3
+#define ADC10_VECTOR 5
+#define USCIAB0TX_VECTOR 6
+#define USCIAB0RX_VECTOR 7
+#define TIMER0_A1_VECTOR 8
+#define TIMER0_A0_VECTOR 9
+#define WDT_VECTOR 10
+#define COMPARATORA_VECTOR 11
+#define TIMER1_A1_VECTOR 12
+#define TIMER1_A0_VECTOR 13
+#define NMI_VECTOR 14
+#define RESET_VECTOR 15
+
+// Status register
+#define C 0x0001
+#define Z 0x0002
+#define N 0x0004
+#define V 0x0100
+#define GIE 0x0008
+#define CPUOFF 0x0010
+#define OSCOFF 0x0020
+#define SCG0 0x0040
+#define SCG1 0x0080
+#define LPM0_bits (CPUOFF)
+#define LPM1_bits (SCG0 + CPUOFF)
+#define LPM2_bits (SCG1 + CPUOFF)
+#define LPM3_bits (SCG1 + SCG0 + CPUOFF)
+#define LPM4_bits (SCG1 + SCG0 + OSCOFF + CPUOFF)
+
+#define BIT0 0x0001
+#define BIT1 0x0002
+#define BIT2 0x0004
+#define BIT3 0x0008
+#define BIT4 0x0010
+#define BIT5 0x0020
+#define BIT6 0x0040
+#define BIT7 0x0080
+#define BIT8 0x0100
+#define BIT9 0x0200
+#define BITA 0x0400
+#define BITB 0x0800
+#define BITC 0x1000
+#define BITD 0x2000
+#define BITE 0x4000
+#define BITF 0x8000
+
+// Special function registers
+#define WDTIE 0x01
+#define OFIE 0x02
+#define NMIIE 0x10
+#define ACCVIE 0x20
+#define WDTIFG 0x01
+#define OFIFG 0x02
+#define PORIFG 0x04
+#define RSTIFG 0x08
+#define NMIIFG 0x10
+#define UCA0RXIE 0x01
+#define UCA0TXIE 0x02
+#define UCB0RXIE 0x04
+#define UCB0TXIE 0x08
+#define UCA0RXIFG 0x01
+#define UCA0TXIFG 0x02
+#define UCB0RXIFG 0x04
+#define UCB0TXIFG 0x08
+
+// Watchdog
+#define WDTPW 0x5A00
+#define WDTHOLD 0x0080
+#define WDTNMIES 0x0040
+#define WDTNMI 0x0020
+#define WDTTMSEL 0x0010
+#define WDTCNTCL 0x0008
+#define WDTSSEL 0x0004
+#define WDTIS1 0x0002
+#define WDTIS0 0x0001
+#define WDT_MDLY_32 (WDTPW + WDTTMSEL + WDTCNTCL)
+#define WDT_MDLY_8 (WDTPW + WDTTMSEL + WDTCNTCL + WDTIS0)
+#define WDT_MDLY_0_5 (WDTPW + WDTTMSEL + WDTCNTCL + WDTIS1)
+#define WDT_MDLY_0_064 (WDTPW + WDTTMSEL + WDTCNTCL + WDTIS1 + WDTIS0)
+#define WDT_ADLY_1000 (WDTPW + WDTTMSEL + WDTCNTCL + WDTSSEL)
+#define WDT_ADLY_250 (WDTPW + WDTTMSEL + WDTCNTCL + WDTSSEL + WDTIS0)
+#define WDT_ADLY_16 (WDTPW + WDTTMSEL + WDTCNTCL + WDTSSEL + WDTIS1)
+#define WDT_ADLY_1_9 (WDTPW + WDTTMSEL + WDTCNTCL + WDTSSEL + WDTIS1 + WDTIS0)
+
+// Basic clock module+
+#define XT2OFF 0x80
+#define XTS 0x40
+#define DIVA_0 0x00
+#define DIVA_1 0x10
+#define DIVA_2 0x20
+#define DIVA_3 0x30
+#define DIVA0 0x10
+#define DIVA1 0x20
+#define SELM_0 0x00
+#define SELM_1 0x40
+#define SELM_2 0x80
+#define SELM_3 0xC0
+#define DIVM_0 0x00
+#define DIVM_1 0x10
+#define DIVM_2 0x20
+#define DIVM_3 0x30
+#define SELS 0x08
+#define DIVS_0 0x00
+#define DIVS_1 0x02
+#define DIVS_2 0x04
+#define DIVS_3 0x06
+#define LFXT1S_0 0x00
+#define LFXT1S_1 0x10
+#define LFXT1S_2 0x20
+#define LFXT1S_3 0x30
+#define XCAP_0 0x00
+#define XCAP_1 0x04
+#define XCAP_2 0x08
+#define XCAP_3 0x0C
+#define LFXT1OF 0x01
+
+// Timer_A
+#define TASSEL_0 0x0000
+#define TASSEL_1 0x0100
+#define TASSEL_2 0x0200
+#define TASSEL_3 0x0300
+#define TASSEL0 0x0100
+#define TASSEL1 0x0200
+#define ID_0 0x0000
+#define ID_1 0x0040
+#define ID_2 0x0080
+#define ID_3 0x00C0
+#define ID0 0x0040
+#define ID1 0x0080
+#define MC_0 0x0000
+#define MC_1 0x0010
+#define MC_2 0x0020
+#define MC_3 0x0030
+#define MC0 0x0010
+#define MC1 0x0020
+#define TACLR 0x0004
+#define TAIE 0x0002
+#define TAIFG 0x0001
+#define CM_0 0x0000
+#define CM_1 0x4000
+#define CM_2 0x8000
+#define CM_3 0xC000
+#define CM1 0x8000
+#define CM0 0x4000
+#define CCIS_0 0x0000
+#define CCIS_1 0x1000
+#define CCIS_2 0x2000
+#define CCIS_3 0x3000
+#define CCIS1 0x2000
+#define CCIS0 0x1000
+#define SCS 0x0800
+#define SCCI 0x0400
+#define CAP 0x0100
+#define OUTMOD_0 0x0000
+#define OUTMOD_1 0x0020
+#define OUTMOD_2 0x0040
+#define OUTMOD_3 0x0060
+#define OUTMOD_4 0x0080
+#define OUTMOD_5 0x00A0
+#define OUTMOD_6 0x00C0
+#define OUTMOD_7 0x00E0
+#define OUTMOD2 0x0080
+#define OUTMOD1 0x0040
+#define OUTMOD0 0x0020
+#define CCIE 0x0010
+#define CCI 0x0008
+#define OUT 0x0004
+#define COV 0x0002
+#define CCIFG 0x0001
+#define TA0IV_NONE 0x0000
+#define TA0IV_TACCR1 0x0002
+#define TA0IV_TACCR2 0x0004
+#define TA0IV_6 0x0006
+#define TA0IV_8 0x0008
+#define TA0IV_TAIFG 0x000A
+#define TA1IV_NONE 0x0000
+#define TA1IV_TACCR1 0x0002
+#define TA1IV_TACCR2 0x0004
+#define TA1IV_3 0x0006
+#define TA1IV_4 0x0008
+#define TA1IV_TAIFG 0x000A
+#define TAIV_NONE TA0IV_NONE
+#define TAIV_TACCR1 TA0IV_TACCR1
+#define TAIV_TACCR2 TA0IV_TACCR2
+#define TAIV_TAIFG TA0IV_TAIFG
+
+// ADC10
+#define ADC10SC 0x0001
+#define ENC 0x0002
+#define ADC10IFG 0x0004
+#define ADC10IE 0x0008
+#define ADC10ON 0x0010
+#define REFON 0x0020
+#define REF2_5V 0x0040
+#define MSC 0x0080
+#define REFBURST 0x0100
+#define REFOUT 0x0200
+#define ADC10SR 0x0400
+#define ADC10SHT0 0x0800
+#define ADC10SHT1 0x1000
+#define SREF0 0x2000
+#define SREF1 0x4000
+#define SREF2 0x8000
+#define ADC10SHT_0 0x0000
+#define ADC10SHT_1 0x0800
+#define ADC10SHT_2 0x1000
+#define ADC10SHT_3 0x1800
+#define SREF_0 0x0000
+#define SREF_1 0x2000
+#define SREF_2 0x4000
+#define SREF_3 0x6000
+#define SREF_4 0x8000
+#define SREF_5 0xA000
+#define SREF_6 0xC000
+#define SREF_7 0xE000
+#define ADC10BUSY 0x0001
+#define CONSEQ0 0x0002
+#define CONSEQ1 0x0004
+#define ADC10SSEL0 0x0008
+#define ADC10SSEL1 0x0010
+#define ADC10DIV0 0x0020
+#define ADC10DIV1 0x0040
+#define ADC10DIV2 0x0080
+#define ISSH 0x0100
+#define ADC10DF 0x0200
+#define SHS0 0x0400
+#define SHS1 0x0800
+#define CONSEQ_0 0x0000
+#define CONSEQ_1 0x0002
+#define CONSEQ_2 0x0004
+#define CONSEQ_3 0x0006
+#define ADC10SSEL_0 0x0000
+#define ADC10SSEL_1 0x0008
+#define ADC10SSEL_2 0x0010
+#define ADC10SSEL_3 0x0018
+#define ADC10DIV_0 0x0000
+#define ADC10DIV_1 0x0020
+#define ADC10DIV_2 0x0040
+#define ADC10DIV_3 0x0060
+#define ADC10DIV_4 0x0080
+#define ADC10DIV_5 0x00A0
+#define ADC10DIV_6 0x00C0
+#define ADC10DIV_7 0x00E0
+#define SHS_0 0x0000
+#define SHS_1 0x0400
+#define SHS_2 0x0800
+#define SHS_3 0x0C00
+#define INCH_0 0x0000
+#define INCH_1 0x1000
+#define INCH_2 0x2000
+#define INCH_3 0x3000
+#define INCH_4 0x4000
+#define INCH_5 0x5000
+#define INCH_6 0x6000
+#define INCH_7 0x7000
+#define INCH_8 0x8000
+#define INCH_9 0x9000
+#define INCH_10 0xA000
+#define INCH_11 0xB000
+#define INCH_12 0xC000
+#define INCH_13 0xD000
+#define INCH_14 0xE000
+#define INCH_15 0xF000
+#define ADC10FETCH 0x01
+#define ADC10B1 0x02
+#define ADC10CT 0x04
+#define ADC10TB 0x08
+
+// Comparator_A+
+#define CAIFG 0x01
+#define CAIE 0x02
+#define CAIES 0x04
+#define CAON 0x08
+#define CAREF0 0x10
+#define CAREF1 0x20
+#define CARSEL 0x40
+#define CAEX 0x80
+#define CAREF_0 0x00
+#define CAREF_1 0x10
+#define CAREF_2 0x20
+#define CAREF_3 0x30
+#define CAOUT 0x01
+#define CAF 0x02
+#define P2CA0 0x04
+#define P2CA1 0x08
+#define P2CA2 0x10
+#define P2CA3 0x20
+#define P2CA4 0x40
+#define CASHORT 0x80
+
+// Flash (registers only, the flash memory itself is not modeled)
+#define FRKEY 0x9600
+#define FWKEY 0xA500
+#define FXKEY 0x3300
+#define ERASE 0x0002
+#define MERAS 0x0004
+#define WRT 0x0040
+#define BLKWRT 0x0080
+#define FN0 0x0001
+#define FN1 0x0002
+#define FN2 0x0004
+#define FN3 0x0008
+#define FN4 0x0010
+#define FN5 0x0020
+#define FSSEL0 0x0040
+#define FSSEL1 0x0080
+#define FSSEL_0 0x0000
+#define FSSEL_1 0x0040
+#define FSSEL_2 0x0080
+#define FSSEL_3 0x00C0
+#define BUSY 0x0001
+#define KEYV 0x0002
+#define ACCVIFG 0x0004
+#define WAIT 0x0008
+#define LOCK 0x0010
+#define EMEX 0x0020
+#define LOCKA 0x0040
+#define FAIL 0x0080
+
+// USCI_B0 in SPI mode
+#define UCCKPH 0x80
+#define UCCKPL 0x40
+#define UCMSB 0x20
+#define UC7BIT 0x10
+#define UCMST 0x08
+#define UCMODE_0 0x00
+#define UCMODE_1 0x02
+#define UCMODE_2 0x04
+#define UCMODE_3 0x06
+#define UCSYNC 0x01
+#define UCSSEL_0 0x00
+#define UCSSEL_1 0x40
+#define UCSSEL_2 0x80
+#define UCSSEL_3 0xC0
+#define UCSWRST 0x01
+#define UCLISTEN 0x80
+#define UCFE 0x40
+#define UCOE 0x20
+#define UCBUSY 0x01
+
+#endif
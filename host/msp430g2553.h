@@ -0,0 +1,7 @@
+/*
+ * msp430g2553.h
+ *
+ * Host replacement, same content as msp430.h.
+ */
+
+#include "msp430.h"
@@ -0,0 +1,214 @@
+#include <msp430g2553.h>
+
+/*
+ * Non-blocking button debouncer on P1.3 with press, release, long-press and double-click events.
+ * blink.c debounces with __delay_cycles() and spins until the release, timer_button_interrupt.c only
+ * watches the falling edge so its release branch never fires reliably. Here:
+ * 1. The first edge masks P1IE.3 and starts a 10 ms tick on Timer_A (ACLK, VLO), the ISR returns at once
+ * 2. The tick re-samples P1IN; DEBOUNCE_TICKS equal samples in a row make the new level valid
+ * 3. P1IES is flipped to the opposite edge of the valid level and P1IE.3 is enabled again
+ * 4. Pressed for LONG_PRESS_TICKS -> long press, second release within DOUBLE_CLICK_TICKS -> double click
+ * 5. When nothing is pending the tick is stopped, the CPU sleeps in LPM3 between events
+ * Events are queued for the main loop: red LED follows the button, double click toggles the green LED,
+ * long press turns both LEDs off.
+ */
+
+#define SW BIT3                 // P1.3 Button
+#define LED_RED BIT0            // P1.0 Red LED
+#define LED_GREEN BIT6          // P1.6 Green LED
+
+#define TICK_ACLK 120           // 10 ms at 12 kHz VLO
+#define DEBOUNCE_TICKS 2        // 20 ms stable
+#define LONG_PRESS_TICKS 100    // 1 s
+#define DOUBLE_CLICK_TICKS 30   // 300 ms between two releases
+
+#define EVT_PRESS 1
+#define EVT_RELEASE 2
+#define EVT_LONG_PRESS 3
+#define EVT_DOUBLE_CLICK 4
+
+#define EVT_QUEUE_SIZE 8        // Power of two
+
+volatile unsigned char evtQueue[EVT_QUEUE_SIZE];
+volatile unsigned char evtHead = 0, evtTail = 0;
+
+unsigned char debouncing = 0;   // Waiting for a stable level
+unsigned char candidate;        // Level being debounced, 1 = pressed
+unsigned char stableCount;
+unsigned char pressed = 0;      // Debounced level
+unsigned int heldTicks;
+unsigned char clickPending = 0; // One click seen, waiting for the second one
+unsigned char clickTicks;
+
+void ConfigWDT(void);
+void ConfigClocks(void);
+void ConfigLEDs(void);
+void ConfigButton(void);
+void ArmEdge(void);
+void PostEvent(unsigned char event);
+unsigned char GetEvent(void);
+
+// Main function
+void main(void) {
+    unsigned char event;
+
+    ConfigWDT();               // Stop the watchdog timer
+    ConfigClocks();            // VLO as ACLK
+    ConfigLEDs();              // Set up LEDs
+    ConfigButton();            // Set up the button interrupt
+
+    while (1) {
+        __disable_interrupt();
+        event = GetEvent();
+        if (!event) {
+            __bis_SR_register(LPM3_bits + GIE); // Sleep until the debouncer posts an event
+            continue;
+        }
+        __enable_interrupt();
+
+        switch (event) {
+            case EVT_PRESS:
+                P1OUT |= LED_RED;
+                break;
+            case EVT_RELEASE:
+                P1OUT &= ~LED_RED;
+                break;
+            case EVT_DOUBLE_CLICK:
+                P1OUT ^= LED_GREEN;
+                break;
+            case EVT_LONG_PRESS:
+                P1OUT &= ~(LED_RED | LED_GREEN);
+                break;
+        }
+    }
+}
+
+// Configurations for the Watchdog Timer
+void ConfigWDT(void) {
+    WDTCTL = WDTPW | WDTHOLD;  // Stop the Watchdog Timer
+}
+
+// Configurations for the clocks
+void ConfigClocks(void) {
+    BCSCTL3 |= LFXT1S_2;       // Set VLO as the source for ACLK (~12 kHz)
+}
+
+// Configurations for the LEDs
+void ConfigLEDs(void) {
+    P1DIR |= LED_RED | LED_GREEN;    // Set P1.0 and P1.6 as output (Red and Green LEDs)
+    P1OUT &= ~(LED_RED | LED_GREEN); // Turn off both LEDs initially
+}
+
+// Configurations for the button on P1.3
+void ConfigButton(void) {
+    P1DIR &= ~SW;              // Set P1.3 as input (Button)
+    P1REN |= SW;               // Enable pull-up/down resistor on P1.3
+    P1OUT |= SW;               // Set P1.3 as pull-up resistor
+    TACCR0 = TICK_ACLK - 1;    // Debounce tick, started on demand
+    TACCTL0 = CCIE;
+    ArmEdge();
+}
+
+// Wait for the edge that leaves the debounced level: falling when released, rising when pressed
+void ArmEdge(void) {
+    if (pressed) {
+        P1IES &= ~SW;          // Rising edge = release
+    } else {
+        P1IES |= SW;           // Falling edge = press
+    }
+    P1IFG &= ~SW;              // Changing P1IES may set P1IFG
+    P1IE |= SW;
+}
+
+void PostEvent(unsigned char event) {
+    unsigned char next = (evtHead + 1) & (EVT_QUEUE_SIZE - 1);
+    if (next != evtTail) {     // Drop the event if main is too far behind
+        evtQueue[evtHead] = event;
+        evtHead = next;
+    }
+}
+
+// Returns 0 if the queue is empty, call with interrupts disabled
+unsigned char GetEvent(void) {
+    unsigned char event;
+    if (evtTail == evtHead) {
+        return 0;
+    }
+    event = evtQueue[evtTail];
+    evtTail = (evtTail + 1) & (EVT_QUEUE_SIZE - 1);
+    return event;
+}
+
+// Port 1 Interrupt Service Routine: first edge of a bounce, hand over to the tick
+#pragma vector = PORT1_VECTOR
+__interrupt void Port_1(void) {
+    if (P1IFG & SW) {
+        P1IE &= ~SW;           // Ignore the rest of the bounce
+        P1IFG &= ~SW;
+        debouncing = 1;
+        candidate = !pressed;
+        stableCount = 0;
+        if (!(TACTL & MC_1)) {
+            TACTL = TASSEL_1 | MC_1 | TACLR; // Start the tick, ACLK, up mode
+        }
+    }
+}
+
+// Timer_A Interrupt Service Routine for CCR0: 10 ms debounce tick
+#pragma vector = TIMER0_A0_VECTOR
+__interrupt void Timer_A(void) {
+    unsigned char level = !(P1IN & SW); // 1 = pressed (active low)
+
+    if (debouncing) {
+        if (level == candidate) {
+            stableCount++;
+        } else {
+            candidate = level;
+            stableCount = 0;
+        }
+        if (stableCount >= DEBOUNCE_TICKS) {
+            debouncing = 0;
+            if (level != pressed) {
+                pressed = level;
+                if (pressed) {
+                    heldTicks = 0;
+                    PostEvent(EVT_PRESS);
+                } else {
+                    PostEvent(EVT_RELEASE);
+                    if (heldTicks >= LONG_PRESS_TICKS) {
+                        clickPending = 0;  // A long press is not a click
+                    } else if (clickPending) {
+                        clickPending = 0;
+                        PostEvent(EVT_DOUBLE_CLICK);
+                    } else {
+                        clickPending = 1;
+                        clickTicks = 0;
+                    }
+                }
+                __bic_SR_register_on_exit(LPM3_bits); // Wake up main loop
+            }
+            ArmEdge();
+            if ((!(P1IN & SW)) != pressed) { // Changed while re-arming, the edge may be lost
+                P1IE &= ~SW;
+                debouncing = 1;
+                candidate = !pressed;
+                stableCount = 0;
+            }
+        }
+    }
+
+    if (pressed && heldTicks < LONG_PRESS_TICKS) {
+        if (++heldTicks == LONG_PRESS_TICKS) {
+            PostEvent(EVT_LONG_PRESS);
+            __bic_SR_register_on_exit(LPM3_bits);
+        }
+    }
+
+    if (clickPending && ++clickTicks >= DOUBLE_CLICK_TICKS) {
+        clickPending = 0;      // Single click only
+    }
+
+    if (!debouncing && !pressed && !clickPending) {
+        TACTL = 0;             // Nothing to time, stop the tick
+    }
+}
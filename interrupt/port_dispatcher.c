@@ -0,0 +1,171 @@
+#include <msp430g2553.h>
+
+/*
+ * Table-driven PORT1/PORT2 interrupt dispatcher.
+ * Every P1 pin shares PORT1_VECTOR (and every P2 pin PORT2_VECTOR), so each new input meant editing one ISR.
+ * Here each pin gets its own handler, registered with PortRegister(port, pin, handler, edge):
+ * 1. The ISR takes the pending pins (PxIFG & PxIE) and serves them lowest pin first, the lowest set bit
+ *    is found with a 16-entry nibble table instead of testing the eight bits one by one
+ * 2. The flag of a pin is cleared (single BIC instruction) before its handler runs, so an edge that arrives
+ *    during the handler raises the interrupt again instead of being lost
+ * 3. A pending pin without a handler, or an ISR entry without any pending pin, counts as spurious
+ * 4. Timer_A counts SMCLK (1 MHz) continuously; for every dispatch the cycles from ISR entry to the handler call
+ *    are measured, the worst case is kept per port and compared against DISPATCH_BUDGET
+ * Demo: button P1.3 toggles the green LED, P1.4 and P1.5 (falling edge, pull-up) toggle the red LED,
+ * the red LED stays on if a dispatch ever exceeds its budget.
+ */
+
+#define LED_RED BIT0            // P1.0 Red LED
+#define LED_GREEN BIT6          // P1.6 Green LED
+
+#define EDGE_RISING 0
+#define EDGE_FALLING 1
+
+#define DISPATCH_BUDGET 40      // SMCLK cycles from ISR entry to handler call
+
+typedef void (*PortHandler)(void);
+
+PortHandler p1Handlers[8];
+PortHandler p2Handlers[8];
+volatile unsigned int spuriousCount = 0;
+volatile unsigned int dispatchMax[2];   // Worst ISR entry -> handler latency per port, in cycles
+volatile unsigned int dispatchOverruns = 0;
+
+// Index of the lowest set bit of a nibble, entry 0 is never used
+static const unsigned char lowestBit[16] = {0, 0, 1, 0, 2, 0, 1, 0, 3, 0, 1, 0, 2, 0, 1, 0};
+
+void ConfigWDT(void);
+void ConfigClocks(void);
+void ConfigLEDs(void);
+void ConfigTimebase(void);
+void PortRegister(unsigned char port, unsigned char pin, PortHandler handler, unsigned char edge);
+void ButtonHandler(void);
+void InputHandler(void);
+
+// Main function
+void main(void) {
+    ConfigWDT();               // Stop the watchdog timer
+    ConfigClocks();            // DCO 1 MHz for the latency measurement
+    ConfigLEDs();              // Set up LEDs
+    ConfigTimebase();
+
+    PortRegister(1, 3, ButtonHandler, EDGE_FALLING);
+    PortRegister(1, 4, InputHandler, EDGE_FALLING);
+    PortRegister(1, 5, InputHandler, EDGE_FALLING);
+
+    while (1) {
+        __bis_SR_register(LPM0_bits + GIE); // Everything is done by the handlers
+    }
+}
+
+// Configurations for the Watchdog Timer
+void ConfigWDT(void) {
+    WDTCTL = WDTPW | WDTHOLD;  // Stop the Watchdog Timer
+}
+
+// Configurations for the clocks
+void ConfigClocks(void) {
+    BCSCTL1 = CALBC1_1MHZ;     // Set DCO to 1 MHz
+    DCOCTL = CALDCO_1MHZ;
+}
+
+// Configurations for the LEDs
+void ConfigLEDs(void) {
+    P1DIR |= LED_RED | LED_GREEN;    // Set P1.0 and P1.6 as output (Red and Green LEDs)
+    P1OUT &= ~(LED_RED | LED_GREEN); // Turn off both LEDs initially
+}
+
+// Timer_A as free running cycle counter for the dispatch latency
+void ConfigTimebase(void) {
+    TACTL = TASSEL_2 | MC_2 | TACLR; // SMCLK, continuous mode
+}
+
+// Register the handler of one pin as an input with pull-up and enable its interrupt
+void PortRegister(unsigned char port, unsigned char pin, PortHandler handler, unsigned char edge) {
+    unsigned char bit = 1 << pin;
+
+    if (port == 1) {
+        P1IE &= ~bit;
+        p1Handlers[pin] = handler;
+        P1DIR &= ~bit;
+        P1REN |= bit;
+        P1OUT |= bit;
+        if (edge == EDGE_FALLING) {
+            P1IES |= bit;
+        } else {
+            P1IES &= ~bit;
+        }
+        P1IFG &= ~bit;         // Changing P1IES may set P1IFG
+        P1IE |= bit;
+    } else {
+        P2IE &= ~bit;
+        p2Handlers[pin] = handler;
+        P2SEL &= ~bit;
+        P2DIR &= ~bit;
+        P2REN |= bit;
+        P2OUT |= bit;
+        if (edge == EDGE_FALLING) {
+            P2IES |= bit;
+        } else {
+            P2IES &= ~bit;
+        }
+        P2IFG &= ~bit;
+        P2IE |= bit;
+    }
+}
+
+void ButtonHandler(void) {
+    P1OUT ^= LED_GREEN;
+}
+
+void InputHandler(void) {
+    if (!dispatchOverruns) {
+        P1OUT ^= LED_RED;
+    }
+}
+
+// Serve the pending pins of one port, lowest pin first
+static inline void Dispatch(volatile unsigned char *ifg, unsigned char enabled, PortHandler *handlers,
+                            unsigned int entry, unsigned char port) {
+    unsigned char pending = *ifg & enabled;
+    unsigned char pin, bit;
+    unsigned int latency;
+
+    if (!pending) {
+        spuriousCount++;       // Entered without a pending enabled pin
+        return;
+    }
+    do {
+        pin = (pending & 0x0F) ? lowestBit[pending & 0x0F] : 4 + lowestBit[pending >> 4];
+        bit = 1 << pin;
+        *ifg &= ~bit;          // Clear before the handler, new edges are kept
+        if (handlers[pin]) {
+            latency = TAR - entry;
+            if (latency > dispatchMax[port]) {
+                dispatchMax[port] = latency;
+            }
+            if (latency > DISPATCH_BUDGET) {
+                dispatchOverruns++;
+                P1OUT |= LED_RED;
+            }
+            handlers[pin]();
+        } else {
+            spuriousCount++;   // Flag without a registered handler
+        }
+        pending = *ifg & enabled; // Pins that fired meanwhile are served in the same entry
+    } while (pending);
+}
+
+// Port 1 Interrupt Service Routine, all P1 pins share PORT1_VECTOR
+#pragma vector = PORT1_VECTOR
+__interrupt void Port_1(void) {
+    unsigned int entry = TAR;
+    Dispatch(&P1IFG, P1IE, p1Handlers, entry, 0);
+}
+
+// Port 2 Interrupt Service Routine, all P2 pins share PORT2_VECTOR
+#pragma vector = PORT2_VECTOR
+__interrupt void Port_2(void) {
+    unsigned int entry = TAR;
+    Dispatch(&P2IFG, P2IE, p2Handlers, entry, 1);
+}
@@ -0,0 +1,227 @@
+/*
+ * LPM_policy.c
+ *
+ * Low-power policy with per-mode residency accounting.
+ * Every peripheral tells the policy which clock it needs while it is busy:
+ *   PM_SMCLK : timers counting SMCLK, the UART while it sends -> deepest mode is LPM0
+ *   PM_ACLK  : timers driven by ACLK (VLO)           -> deepest mode is LPM3
+ *   nothing requested                                -> LPM4, only an interrupt pin wakes the CPU
+ * pmSleep() picks the deepest LPM that keeps every requested clock alive.
+ * Timer1_A runs from ACLK in continuous mode as the time base of the accounting, so this program keeps ACLK
+ * requested and never reaches LPM4 (the time base would stop with it). The ticks before and after each sleep
+ * are added to that mode, everything else is active time (ISRs that wake the CPU are counted as part of the sleep).
+ * The program measures the temperature every second and every REPORT_SECONDS it sends to the PC:
+ *   residency of active mode, LPM0 and LPM3 in percent
+ *   estimated average current from the datasheet figures (typical, 1 MHz, 2.2 V)
+ *   the last temperature reading (ADC10 counts)
+ * The reference and the ADC10 are on only for the ~100 us of each reading (settling and conversion, CPU active),
+ * they would add several hundred uA in every mode otherwise and the core currents would not cover the estimate.
+ * UART: 9600 baud, 8-bit data, 1 stop bit, TX only on P1.1. A report fits the driver's TX ring, pmSleep() keeps
+ * SMCLK while the ring drains (uartTxIdle) and the TXD ISR wakes the CPU after every byte to re-check.
+ * Build with ../driver/system.c ../driver/uart.c and -DUART_RING -DUART_TX_SIZE=64.
+ */
+
+#include "msp430.h"
+#include "../driver/system.h"
+#include "../driver/uart.h"
+
+#if !defined(UART_RING) || UART_TX_SIZE < 64
+#error "LPM_policy.c queues a whole report, build with -DUART_RING -DUART_TX_SIZE=64"
+#endif
+
+#define ACLK_HZ 12000 // VLO, see Timer/VLO_calibration.c for a calibrated value
+#define REPORT_SECONDS 10
+
+#define PM_ACLK  0   // Clock requested by a peripheral, index in pmRequests[]
+#define PM_SMCLK 1
+
+#define PM_ACTIVE 0   // Index in pmResidency[]
+#define PM_LPM0 1
+#define PM_LPM3 2
+#define PM_MODES 3
+
+// Typical supply current from the MSP430G2553 datasheet in nA (1 MHz, 2.2 V)
+#define I_ACTIVE_NA 230000UL
+#define I_LPM0_NA 56000UL
+#define I_LPM3_NA 500UL
+
+unsigned char pmRequests[2]; // Reference count per clock
+unsigned long pmResidency[PM_MODES]; // ACLK ticks spent in each mode since the last report
+unsigned long pmWindowStart;
+volatile unsigned int timebaseHigh = 0; // Timer1_A overflows, upper word of the time base
+volatile unsigned char secondTick = 0;
+volatile unsigned char reportDue = 0;
+unsigned int temperature;
+
+void configP1_UART(void);
+void configTimebase(void);
+void configADC10(void);
+unsigned int readTemperature(void);
+void pmRequire(unsigned char clock);
+void pmSleep(void);
+void pmReport(void);
+unsigned long readTimebase(void);
+
+void main(void) {
+    configWDT();
+    configClocks();
+    configP1_UART();
+    configADC10();
+    configTimebase();
+    __enable_interrupt();
+
+    pmRequire(PM_ACLK); // Time base and 1 second tick
+    pmWindowStart = readTimebase();
+    TimerA_UART_print("LPM policy READY.\r\n");
+
+    for (;;) {
+        __disable_interrupt(); // No wake-up may slip in between the check and the sleep
+        while (!secondTick) {  // TX completions also wake the CPU
+            pmSleep();
+            __disable_interrupt();
+        }
+        secondTick = 0;
+        __enable_interrupt();
+
+        temperature = readTemperature();
+
+        if (reportDue) {
+            reportDue = 0;
+            pmReport();
+        }
+    }
+}
+
+void configP1_UART(void) {
+    P1OUT = 0x00;             // Initialize all GPIO
+    P1DIR = 0xFF;             // Set pins to output
+    TimerA_UART_init();       // Timer0_A from SMCLK, frozen while SMCLK is off
+}
+
+void configADC10(void) {
+    ADC10CTL1 = INCH_10 + ADC10DIV_3; // Temp Sensor ADC10CLK/4
+}
+
+// One conversion with the reference on only meanwhile
+unsigned int readTemperature(void) {
+    unsigned int value;
+
+    ADC10CTL0 = SREF_1 + ADC10SHT_3 + REFON + ADC10ON; // Internal ref on, ADC on
+    __delay_cycles(30);         // Reference settling, 30 us at 1 MHz
+    ADC10CTL0 |= ENC + ADC10SC; // Sampling and conversion start
+    while (ADC10CTL1 & ADC10BUSY);
+    value = ADC10MEM;
+    ADC10CTL0 &= ~ENC;
+    ADC10CTL0 = 0;              // Reference and ADC10 off
+    return value;
+}
+
+// Timer1_A: ACLK continuous mode, TAIFG extends TA1R to 32 bits, CCR0 gives the 1 second tick
+void configTimebase(void) {
+    TA1CCR0 = ACLK_HZ;
+    TA1CCTL0 = CCIE;
+    TA1CTL = TASSEL_1 + MC_2 + TACLR + TAIE; // ACLK, continuous mode, overflow interrupt
+}
+
+void pmRequire(unsigned char clock) {
+    __disable_interrupt();
+    pmRequests[clock]++;
+    __enable_interrupt();
+}
+
+// Call with interrupts disabled, returns with interrupts enabled after the wake-up
+void pmSleep(void) {
+    unsigned long before, after;
+    unsigned char mode;
+
+    before = readTimebase();
+    if (pmRequests[PM_SMCLK] || !uartTxIdle(&uart0)) { // The UART needs SMCLK until its ring is empty
+        mode = PM_LPM0;
+        __bis_SR_register(LPM0_bits + GIE); // CPU off only
+    } else if (pmRequests[PM_ACLK]) {
+        mode = PM_LPM3;
+        __bis_SR_register(LPM3_bits + GIE); // Only ACLK left running
+    } else {
+        __bis_SR_register(LPM4_bits + GIE); // All clocks off, the time base stops: not accounted
+        return;
+    }
+    __disable_interrupt();
+    after = readTimebase();
+    pmResidency[mode] += after - before;
+    __enable_interrupt();
+}
+
+// Timer1_A runs asynchronously to MCLK, read until two consecutive values agree
+unsigned long readTimebase(void) {
+    unsigned int low, high;
+    unsigned short state = __get_SR_register() & GIE;
+
+    __disable_interrupt();
+    do {
+        low = TA1R;
+    } while (low != TA1R);
+    high = timebaseHigh;
+    if ((TA1CTL & TAIFG) && low < 0x8000) { // Overflow not yet served by the ISR
+        high++;
+    }
+    __bis_SR_register(state);
+    return ((unsigned long)high << 16) | low;
+}
+
+void pmReport(void) {
+    unsigned long now, total, permille, currentNA = 0;
+    unsigned long ticks[PM_MODES];
+    unsigned char mode;
+    static const char *names[PM_MODES] = {"ACTIVE ", " LPM0 ", " LPM3 "};
+    static const unsigned long currents[PM_MODES] = {I_ACTIVE_NA, I_LPM0_NA, I_LPM3_NA};
+
+    // Close the window and start the next one, the report itself is accounted in the next window
+    __disable_interrupt();
+    now = readTimebase();
+    total = now - pmWindowStart;
+    ticks[PM_ACTIVE] = total - pmResidency[PM_LPM0] - pmResidency[PM_LPM3];
+    for (mode = PM_LPM0; mode < PM_MODES; mode++) {
+        ticks[mode] = pmResidency[mode];
+        pmResidency[mode] = 0;
+    }
+    pmWindowStart = now;
+    __enable_interrupt();
+
+    for (mode = 0; mode < PM_MODES; mode++) {
+        permille = (ticks[mode] * 1000) / total;
+        currentNA += (permille * currents[mode]) / 1000;
+        TimerA_UART_print((char *)names[mode]);
+        TimerA_UART_printNum((unsigned int)(permille / 10));
+        TimerA_UART_tx('.');
+        TimerA_UART_tx(permille % 10 + '0');
+        TimerA_UART_tx('%');
+    }
+    TimerA_UART_print(" AVG ");
+    TimerA_UART_printNum((unsigned int)(currentNA / 1000));
+    TimerA_UART_tx('.');
+    TimerA_UART_tx((currentNA % 1000) / 100 + '0');
+    TimerA_UART_print("uA TEMP ");
+    TimerA_UART_printNum(temperature);
+    TimerA_UART_print("\r\n");
+}
+
+#pragma vector = TIMER1_A0_VECTOR  // 1 second tick
+__interrupt void Timer1_A0_ISR(void) {
+    static unsigned char seconds = 0;
+    TA1CCR0 += ACLK_HZ;
+    secondTick = 1;
+    if (++seconds >= REPORT_SECONDS) {
+        seconds = 0;
+        reportDue = 1;
+    }
+    __bic_SR_register_on_exit(LPM3_bits); // Wake up main loop
+}
+
+#pragma vector = TIMER1_A1_VECTOR  // Time base overflow
+__interrupt void Timer1_A1_ISR(void) {
+    switch (__even_in_range(TA1IV, TA1IV_TAIFG)) {
+        case TA1IV_TAIFG:
+            timebaseHigh++;
+            break;
+    }
+}
@@ -0,0 +1,190 @@
+/*
+ * vccAdaptive.c
+ *
+ * Temperature logger that adapts to the coin cell it runs from.
+ * Every VCC_CHECK_TICKS vccRead() converts Vcc/2 (ADC10 channel 11, reference on for ~100 us only) and the
+ * policy picks the level of vccLevels[]: as Vcc drops, samples come less often, fewer conversions are averaged
+ * per sample and telemetry lines are rarer. A level is left downwards below its minMv and re-entered from below
+ * only VCC_HYST_MV above it, so the noise of the measurement does not make it chatter.
+ * The DCO never runs faster than the datasheet rates at Vcc - VCC_MARGIN_MV (vcc.h): the program starts at
+ * 1 MHz, measures Vcc and only then goes up to CLOCK_MHZ if allowed; a lower Vcc steps it down at the next check.
+ * The UART bit time follows the clock (uartClock), the tick comes from Timer1_A on ACLK (VLO) and does not.
+ * Tick 100 ms, LPM3 between ticks once the last byte is out.
+ * "POLICY LEVEL <level> MHZ <MHz> VCC <mV>" on every change,
+ * "VCC <mV> MHZ <MHz> LEVEL <level> TEMP <ADC10 average> N <conversions>" per telemetry line.
+ * Build with ../driver/system.c ../driver/uart.c ../driver/adc.c ../driver/vcc.c, e.g. -DCLOCK_MHZ=16;
+ * host/examples/vccAdaptive.txt discharges the cell in the host model.
+ */
+
+#include "msp430.h"
+#include "../driver/system.h"
+#include "../driver/uart.h"
+#include "../driver/adc.h"
+#include "../driver/vcc.h"
+
+#define TICK_ACLK 1200          // 100 ms of the ~12 kHz VLO
+#define VCC_CHECK_TICKS 10      // Vcc every second: at most ~50 mV of a discharge between two checks
+#define VCC_HYST_MV 50
+#define LEVELS 4
+
+const struct vccLevel {
+    unsigned int minMv;         // Lowest Vcc of the level
+    unsigned char samplePeriod; // Ticks between samples
+    unsigned char shift;        // 1 << shift conversions averaged per sample
+    unsigned char telemetry;    // Samples per telemetry line
+} vccLevels[LEVELS] = {
+    {2900, 1, 4, 10},           // Fresh cell: 10 samples/s of 16 conversions, a line every second
+    {2700, 5, 3, 4},            // 2 samples/s of 8, every 2 s
+    {2400, 20, 2, 3},           // A sample every 2 s of 4, every 6 s
+    {0, 100, 0, 3}              // Nearly empty: a single conversion every 10 s, every 30 s
+};
+
+volatile unsigned char tickDue = 0;
+unsigned char level = 0, clockMHz = 1;
+unsigned int vccMv, temperature;
+
+void configP1(void);
+void configTick(void);
+void setClock(unsigned char mhz);
+unsigned char policy(void);
+void policyReport(void);
+unsigned int sample(unsigned char shift);
+void telemetry(void);
+
+void main(void) {
+    unsigned char vccTicks = 0, sampleTicks = 0, samples = 0;
+
+    configWDT();
+    configDCO(1);               // Rated down to 1.8 V, whatever the cell holds
+    BCSCTL3 |= LFXT1S_2;        // Set VLO as the source for ACLK (~12 kHz)
+    configP1();
+    TimerA_UART_init();
+    uartClock(&uart0, 1000000UL, UART_BAUD);
+    configTick();
+    __enable_interrupt();
+
+    vccMv = vccRead();
+    level = LEVELS - 1;         // Climb to the level of the cell
+    policy();
+    policyReport();
+
+    for (;;) {
+        while (!uartTxIdle(&uart0)); // SMCLK stops in LPM3
+        __disable_interrupt();
+        while (!tickDue) {
+            __bis_SR_register(LPM3_bits + GIE); // Wait for the tick
+            __disable_interrupt();
+        }
+        tickDue = 0;
+        __enable_interrupt();
+
+        if (++vccTicks >= VCC_CHECK_TICKS) {
+            vccTicks = 0;
+            vccMv = vccRead();
+            if (policy()) {
+                policyReport();
+            }
+        }
+        if (++sampleTicks >= vccLevels[level].samplePeriod) {
+            sampleTicks = 0;
+            temperature = sample(vccLevels[level].shift);
+            if (++samples >= vccLevels[level].telemetry) {
+                samples = 0;
+                telemetry();
+            }
+        }
+    }
+}
+
+void configP1(void) {
+    P1OUT = 0x00;               // Initialize all GPIO
+    P1DIR = 0xFF & ~UART_RXD;   // Set pins to output
+}
+
+void configTick(void) {
+    TA1CCR0 = TICK_ACLK - 1;
+    TA1CCTL0 = CCIE;
+    TA1CTL = TASSEL_1 + MC_1 + TACLR; // ACLK, up mode
+}
+
+// DCO and UART bit time together, after the last byte
+void setClock(unsigned char mhz) {
+    while (!uartTxIdle(&uart0));
+    configDCO(mhz);
+    uartClock(&uart0, mhz * 1000000UL, UART_BAUD);
+    clockMHz = mhz;
+}
+
+// Level and clock for vccMv, 1 when one of them changed
+unsigned char policy(void) {
+    unsigned char newLevel = level, mhz;
+
+    while (vccMv < vccLevels[newLevel].minMv) {
+        newLevel++;             // The last level has minMv 0
+    }
+    while (newLevel && vccMv >= vccLevels[newLevel - 1].minMv + VCC_HYST_MV) {
+        newLevel--;
+    }
+    mhz = vccMaxMHz(vccMv);     // Down at once
+    if (mhz >= clockMHz) {
+        mhz = vccMv > VCC_HYST_MV ? vccMaxMHz(vccMv - VCC_HYST_MV) : 1; // Up only with the hysteresis
+        if (mhz > CLOCK_MHZ) {
+            mhz = CLOCK_MHZ;
+        }
+        if (mhz < clockMHz) {
+            mhz = clockMHz;
+        }
+    }
+    if (newLevel == level && mhz == clockMHz) {
+        return 0;
+    }
+    if (mhz != clockMHz) {
+        setClock(mhz);
+    }
+    level = newLevel;
+    return 1;
+}
+
+void policyReport(void) {
+    TimerA_UART_print("POLICY LEVEL ");
+    TimerA_UART_printNum(level);
+    TimerA_UART_print(" MHZ ");
+    TimerA_UART_printNum(clockMHz);
+    TimerA_UART_print(" VCC ");
+    TimerA_UART_printNum(vccMv);
+    TimerA_UART_print("\r\n");
+}
+
+// Average of 1 << shift temperature sensor conversions, the reference only on meanwhile
+unsigned int sample(unsigned char shift) {
+    unsigned int sum = 0, n = 1 << shift;
+
+    configADC(INCH_10);
+    __delay_cycles(CLOCK_MHZ * 30); // Reference settling, 30 us at the highest clock of the build
+    while (n--) {
+        sum += readADC();       // 16 * 1023 fits
+    }
+    ADC10CTL0 &= ~ENC;
+    ADC10CTL0 = 0;              // Reference and ADC10 off
+    return sum >> shift;
+}
+
+void telemetry(void) {
+    TimerA_UART_print("VCC ");
+    TimerA_UART_printNum(vccMv);
+    TimerA_UART_print(" MHZ ");
+    TimerA_UART_printNum(clockMHz);
+    TimerA_UART_print(" LEVEL ");
+    TimerA_UART_printNum(level);
+    TimerA_UART_print(" TEMP ");
+    TimerA_UART_printNum(temperature);
+    TimerA_UART_print(" N ");
+    TimerA_UART_printNum(1 << vccLevels[level].shift);
+    TimerA_UART_print("\r\n");
+}
+
+#pragma vector = TIMER1_A0_VECTOR  // 100 ms tick
+__interrupt void Timer1_A0_ISR(void) {
+    tickDue = 1;
+    __bic_SR_register_on_exit(LPM3_bits);
+}
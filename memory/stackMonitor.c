@@ -0,0 +1,167 @@
+/*
+ * stackMonitor.c
+ *
+ * Stack high-water mark and RAM headroom of a soft UART + ADC10 program.
+ * lnk_msp430g2253.cmd puts .bss, .data, .sysmem and .stack (placed HIGH) into the same 256 bytes of RAM,
+ * nothing stops the stack from growing into the globals when ISRs nest.
+ * 1. _system_pre_init() runs before the C startup initializes the globals and fills the .stack section
+ *    (_stack .. __STACK_END, symbols from the TI linker) with STACK_PAINT, except the words already in use
+ * 2. stackUsed() scans up from the bottom of the stack for the first word that is not STACK_PAINT anymore,
+ *    everything above it has been written at least once: the high-water mark
+ * 3. With STACK_CANARY (default 1, -DSTACK_CANARY=0 drops it) the lowest stack word holds CANARY_VALUE and the
+ *    1 second tick checks it, a broken canary means the stack reached its end: red LED on and "CANARY" in the report
+ * Every REPORT_SECONDS: "STACK <used> FREE <free> SIZE <size> STATIC <bytes of RAM below the stack>"
+ * Load: the soft UART echoes (TX and RX ISRs), the tick starts a temperature conversion every second and the
+ * ADC10 ISR enables interrupts again, so the UART ISRs can nest on top of it as in the worst case.
+ * Tune .stack (-stack option) and the buffer sizes of new features until FREE leaves enough margin.
+ */
+
+#include "msp430.h"
+#include "../driver/system.h"
+#include "../driver/uart.h"
+#include "../driver/adc.h"
+
+// Build with ../driver/system.c ../driver/uart.c ../driver/adc.c and -DUART_RX
+
+#ifndef UART_RX
+#error "stackMonitor.c echoes received bytes through uart0.rxReady, build with -DUART_RX"
+#endif
+
+#define LED_RED 0x01            // P1.0 - Red LED
+
+#define STACK_PAINT 0xA55A      // Pattern unlikely to be a return address or a counter
+#ifndef STACK_CANARY
+#define STACK_CANARY 1          // 0: no canary check in the tick
+#endif
+#define CANARY_VALUE 0xDEAD
+#define RAM_START 0x0200
+#define REPORT_SECONDS 5
+
+extern unsigned int _stack;     // Lowest address of .stack, from the linker
+extern unsigned int __STACK_END; // One past the highest address
+extern unsigned int __STACK_SIZE;
+
+volatile unsigned char reportDue = 0;
+volatile unsigned char canaryBroken = 0;
+volatile unsigned int temperature;
+
+void configP1(void);
+void configTick(void);
+unsigned int stackUsed(void);
+void stackReport(void);
+
+// Called by the C startup before .bss/.data are initialized, return 1 to let it initialize them
+int _system_pre_init(void) {
+    unsigned int *p = &_stack;
+    unsigned int *sp = (unsigned int *)__get_SP_register();
+
+    WDTCTL = WDTPW | WDTHOLD;   // Painting must not run into the watchdog
+    while (p < sp - 2) {        // Keep clear of this frame
+        *p++ = STACK_PAINT;
+    }
+#if STACK_CANARY
+    _stack = CANARY_VALUE;
+#endif
+    return 1;
+}
+
+void main(void) {
+    configWDT();
+    configClocks();
+    configP1();
+    configADC(INCH_10);
+    ADC10CTL0 |= ADC10IE;
+    TimerA_UART_init();
+    configTick();
+    __enable_interrupt();
+
+    TimerA_UART_print("Stack monitor READY.\r\n");
+    stackReport();
+
+    for (;;) {
+        __disable_interrupt();
+        while (!uart0.rxReady && !reportDue) {
+            __bis_SR_register(LPM0_bits + GIE); // Wait for a character or the report
+            __disable_interrupt();
+        }
+        __enable_interrupt();
+
+        if (uart0.rxReady) {
+            uart0.rxReady = 0;
+            TimerA_UART_tx(uart0.rxBuffer); // Echo
+        }
+        if (reportDue) {
+            reportDue = 0;
+            stackReport();
+        }
+    }
+}
+
+void configP1(void) {
+    P1OUT = 0x00;             // Initialize all GPIO
+    P1DIR = 0xFF & ~UART_RXD; // Set pins to output
+}
+
+// 1 second tick from ACLK (VLO ~12 kHz) on Timer1_A, Timer0_A is the UART
+void configTick(void) {
+    TA1CCR0 = 12000 - 1;
+    TA1CCTL0 = CCIE;
+    TA1CTL = TASSEL_1 + MC_1 + TACLR; // ACLK, up mode
+}
+
+// Bytes of .stack written at least once since reset
+unsigned int stackUsed(void) {
+    unsigned int *p = &_stack;
+
+#if STACK_CANARY
+    p++;                        // The canary is not paint
+#endif
+    while (p < &__STACK_END && *p == STACK_PAINT) {
+        p++;
+    }
+    return (unsigned int)&__STACK_END - (unsigned int)p;
+}
+
+void stackReport(void) {
+    unsigned int used = stackUsed();
+    unsigned int size = (unsigned int)&__STACK_SIZE;
+
+    TimerA_UART_print("STACK ");
+    TimerA_UART_printNum(used);
+    TimerA_UART_print(" FREE ");
+    TimerA_UART_printNum(size - used);
+    TimerA_UART_print(" SIZE ");
+    TimerA_UART_printNum(size);
+    TimerA_UART_print(" STATIC ");
+    TimerA_UART_printNum((unsigned int)&_stack - RAM_START);
+    if (canaryBroken) {
+        TimerA_UART_print(" CANARY");
+    }
+    TimerA_UART_print("\r\n");
+}
+
+#pragma vector = TIMER1_A0_VECTOR  // 1 second tick
+__interrupt void Timer1_A0_ISR(void) {
+    static unsigned char seconds = 0;
+
+#if STACK_CANARY
+    if (_stack != CANARY_VALUE && !canaryBroken) {
+        canaryBroken = 1;
+        P1OUT |= LED_RED;
+        reportDue = 1;
+        __bic_SR_register_on_exit(LPM0_bits);
+    }
+#endif
+    ADC10CTL0 |= ENC + ADC10SC; // Load for the next second
+    if (++seconds >= REPORT_SECONDS) {
+        seconds = 0;
+        reportDue = 1;
+        __bic_SR_register_on_exit(LPM0_bits);
+    }
+}
+
+#pragma vector = ADC10_VECTOR
+__interrupt void ADC10_ISR(void) {
+    __enable_interrupt();       // Let the UART bit ISRs nest on top, the deepest stack
+    temperature = ADC10MEM;
+}
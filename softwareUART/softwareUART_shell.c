@@ -0,0 +1,304 @@
+/*
+Temperature monitor with a command shell on the software UART
+The sampling period, the threshold and the report mode used to be constants (TACCR0, 737), changing them meant reflashing.
+Here they are parameters that the PC reads and writes at runtime while the sampling keeps running:
+1. The RXD ISR only puts each byte in a small ring buffer and wakes the main loop (driver UART_RING)
+2. The main loop takes one byte at a time, echoes it and collects the line (backspace supported)
+3. On CR the line is split into words and looked up in a static command table, no dynamic memory
+4. TX is buffered too: TimerA_UART_tx queues the byte and the TXD ISR starts the next one after the stop bit,
+   so a long answer never stops the 1 second sampling (Timer1_A on ACLK)
+Commands:
+  help                 list the commands
+  get <name>           show a parameter (period, thresh, mode)
+  set <name> <value>   change a parameter
+  stat                 samples, HI/LO/IN counts and lost RX bytes
+  meas                 measure now and report
+Reports like softwareUART_application3.c: HI/LO/IN (mode 0), the raw reading (mode 1) or nothing (mode 2),
+red LED above the threshold. UART: 9600 baud, 8-bit data, 1 stop bit, SMCLK at 1MHz.
+Build with ../driver/system.c ../driver/uart.c and -DUART_RX -DUART_RING (RX ring 8, TX ring 32 bytes).
+*/
+
+#include "msp430.h"
+#include "../driver/system.h"
+#include "../driver/uart.h"
+
+#if !defined(UART_RX) || !defined(UART_RING)
+#error "softwareUART_shell.c reads commands through the driver rings, build with -DUART_RX -DUART_RING"
+#endif
+
+#define LED_RED 0x01   // P1.0 - Red LED
+#define LED_GREEN 0x40 // P1.6 - Green LED
+
+#define LINE_SIZE 24
+#define MAX_WORDS 3
+
+struct command {
+    const char *name;
+    void (*handler)(unsigned char argc, char **argv);
+};
+
+struct parameter {
+    const char *name;
+    unsigned int *value;
+    unsigned int min, max;
+};
+
+volatile unsigned char secondTick = 0;
+
+char line[LINE_SIZE];
+unsigned char lineLength = 0;
+
+unsigned int samplePeriod = 1;  // Seconds between two samples
+unsigned int threshold = 737;   // Red LED above
+unsigned int reportMode = 0;    // 0 HI/LO/IN, 1 raw, 2 quiet
+unsigned int previousTemp = 0, currentTemp = 0;
+unsigned int samples = 0, countHi = 0, countLo = 0, countIn = 0;
+
+void configP1_UART(void);
+void configLEDs(void);
+void configADC(void);
+void configTimer1s(void);
+void measure(void);
+void shellInput(unsigned char c);
+void shellExecute(void);
+unsigned char parseNum(const char *s, unsigned int *value);
+unsigned char strEqual(const char *a, const char *b);
+void cmdHelp(unsigned char argc, char **argv);
+void cmdGet(unsigned char argc, char **argv);
+void cmdSet(unsigned char argc, char **argv);
+void cmdStat(unsigned char argc, char **argv);
+void cmdMeas(unsigned char argc, char **argv);
+
+static const struct command commands[] = {
+    {"help", cmdHelp},
+    {"get", cmdGet},
+    {"set", cmdSet},
+    {"stat", cmdStat},
+    {"meas", cmdMeas},
+};
+#define COMMANDS (sizeof(commands) / sizeof(commands[0]))
+
+static const struct parameter parameters[] = {
+    {"period", &samplePeriod, 1, 3600},
+    {"thresh", &threshold, 0, 1023},
+    {"mode", &reportMode, 0, 2},
+};
+#define PARAMETERS (sizeof(parameters) / sizeof(parameters[0]))
+
+void main(void) {
+    unsigned int seconds = 0;
+
+    configWDT();
+    configClocks();
+    configP1_UART();
+    TimerA_UART_init();       // Right after the pins, TXD is a low GPIO until then
+    configLEDs();
+    configADC();
+    configTimer1s();
+    __enable_interrupt();
+
+    TimerA_UART_print("Temperature shell, type help\r\n> ");
+
+    for (;;) {
+        __disable_interrupt();
+        if (!uartRxAvail(&uart0) && !secondTick) {
+            __bis_SR_register(LPM0_bits + GIE); // Wait for a byte or the tick
+            continue;
+        }
+        __enable_interrupt();
+
+        if (secondTick) {
+            secondTick = 0;
+            if (++seconds >= samplePeriod) {
+                seconds = 0;
+                measure();
+            }
+        }
+        while (uartRxAvail(&uart0)) { // One byte at a time
+            shellInput(uartRx(&uart0));
+        }
+    }
+}
+
+void configP1_UART(void) {
+    P1OUT = 0x00;             // Initialize all GPIO
+    P1DIR = 0xFF & ~UART_RXD; // Set pins to output, TimerA_UART_init selects TXD/RXD
+}
+
+void configLEDs(void) {
+    P1DIR |= LED_RED + LED_GREEN; // Set LED pins as outputs
+    P1OUT &= ~(LED_RED + LED_GREEN); // Turn off LEDs initially
+}
+
+void configADC(void) {
+    ADC10CTL1 = INCH_10 + ADC10DIV_3; // Temp Sensor ADC10CLK/4
+    ADC10CTL0 = SREF_1 + ADC10SHT_3 + REFON + ADC10ON; // Internal ref on, ADC on
+}
+
+void measure(void) {
+    ADC10CTL0 |= ENC + ADC10SC; // Sampling and conversion start
+    while (ADC10CTL1 & ADC10BUSY); // Wait until conversion is complete
+    currentTemp = ADC10MEM;
+    samples++;
+
+    if (currentTemp > threshold) {
+        P1OUT |= LED_RED;
+    } else {
+        P1OUT &= ~LED_RED;
+    }
+    if (reportMode == 1) {
+        TimerA_UART_printNum(currentTemp);
+        TimerA_UART_print("\r\n");
+    }
+    if (currentTemp > previousTemp) {
+        countHi++;
+        if (reportMode == 0) TimerA_UART_print("HI\r\n");
+    } else if (currentTemp < previousTemp) {
+        countLo++;
+        if (reportMode == 0) TimerA_UART_print("LO\r\n");
+    } else {
+        countIn++;
+        if (reportMode == 0) TimerA_UART_print("IN\r\n");
+    }
+    previousTemp = currentTemp;
+}
+
+// Collect one received byte into the line, execute on CR
+void shellInput(unsigned char c) {
+    if (c == '\r') {
+        TimerA_UART_print("\r\n");
+        line[lineLength] = '\0';
+        shellExecute();
+        lineLength = 0;
+        TimerA_UART_print("> ");
+    } else if (c == '\b' || c == 0x7F) {
+        if (lineLength) {
+            lineLength--;
+            TimerA_UART_print("\b \b");
+        }
+    } else if (c >= ' ' && lineLength < LINE_SIZE - 1) {
+        line[lineLength++] = c;
+        TimerA_UART_tx(c);      // Echo
+    }
+}
+
+// Split the line into words in place and run the matching command
+void shellExecute(void) {
+    char *argv[MAX_WORDS];
+    unsigned char argc = 0, i;
+    char *p = line;
+
+    while (*p && argc < MAX_WORDS) {
+        while (*p == ' ') *p++ = '\0';
+        if (!*p) break;
+        argv[argc++] = p;
+        while (*p && *p != ' ') p++;
+    }
+    while (*p == ' ') *p++ = '\0';
+    if (argc == 0) {
+        return;
+    }
+    for (i = 0; i < COMMANDS; i++) {
+        if (strEqual(argv[0], commands[i].name)) {
+            commands[i].handler(argc, argv);
+            return;
+        }
+    }
+    TimerA_UART_print("unknown command\r\n");
+}
+
+unsigned char strEqual(const char *a, const char *b) {
+    while (*a && *a == *b) {
+        a++;
+        b++;
+    }
+    return *a == *b;
+}
+
+// Decimal number, returns 0 if the string is not a number below 65536
+unsigned char parseNum(const char *s, unsigned int *value) {
+    unsigned long v = 0;
+
+    if (!*s) return 0;
+    while (*s) {
+        if (*s < '0' || *s > '9') return 0;
+        v = v * 10 + (*s++ - '0');
+        if (v > 0xFFFF) return 0;
+    }
+    *value = (unsigned int)v;
+    return 1;
+}
+
+const struct parameter *findParameter(const char *name) {
+    unsigned char i;
+    for (i = 0; i < PARAMETERS; i++) {
+        if (strEqual(name, parameters[i].name)) {
+            return &parameters[i];
+        }
+    }
+    TimerA_UART_print("unknown parameter\r\n");
+    return 0;
+}
+
+void cmdHelp(unsigned char argc, char **argv) {
+    (void)argc;
+    (void)argv;
+    TimerA_UART_print("get|set period|thresh|mode [value], stat, meas\r\n");
+}
+
+void cmdGet(unsigned char argc, char **argv) {
+    const struct parameter *p;
+    if (argc < 2 || !(p = findParameter(argv[1]))) return;
+    TimerA_UART_printNum(*p->value);
+    TimerA_UART_print("\r\n");
+}
+
+void cmdSet(unsigned char argc, char **argv) {
+    const struct parameter *p;
+    unsigned int value;
+    if (argc < 3 || !(p = findParameter(argv[1]))) return;
+    if (!parseNum(argv[2], &value) || value < p->min || value > p->max) {
+        TimerA_UART_print("bad value\r\n");
+        return;
+    }
+    *p->value = value;
+    TimerA_UART_print("OK\r\n");
+}
+
+void cmdStat(unsigned char argc, char **argv) {
+    (void)argc;
+    (void)argv;
+    TimerA_UART_print("samples ");
+    TimerA_UART_printNum(samples);
+    TimerA_UART_print(" HI ");
+    TimerA_UART_printNum(countHi);
+    TimerA_UART_print(" LO ");
+    TimerA_UART_printNum(countLo);
+    TimerA_UART_print(" IN ");
+    TimerA_UART_printNum(countIn);
+    TimerA_UART_print(" rxlost ");
+    TimerA_UART_printNum(uart0.rxLost);
+    TimerA_UART_print("\r\n");
+}
+
+void cmdMeas(unsigned char argc, char **argv) {
+    unsigned int mode = reportMode;
+
+    (void)argc;
+    (void)argv;
+    reportMode = 1;             // Always answer with the reading
+    measure();
+    reportMode = mode;
+}
+
+void configTimer1s(void) {
+    TA1CCR0 = 12000 - 1;      // 1 second from ACLK (VLO ~12 kHz)
+    TA1CCTL0 = CCIE;
+    TA1CTL = TASSEL_1 + MC_1 + TACLR; // ACLK, up mode
+}
+
+#pragma vector = TIMER1_A0_VECTOR  // 1 second tick
+__interrupt void Timer1_A0_ISR(void) {
+    secondTick = 1;
+    __bic_SR_register_on_exit(LPM0_bits); // Wake up main loop
+}
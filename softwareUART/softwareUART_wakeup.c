@@ -0,0 +1,128 @@
+/*
+Software UART listener that waits for the PC in LPM4, 9600 baud, echo, 8-bit data, 1 stop bit, SMCLK at 1MHz
+TimerA_UART_init keeps SMCLK and Timer0_A running forever, so the chip can never go below LPM0.
+Here the listener parks RXD (P1.2) as a plain GPIO with a falling edge interrupt and sleeps in LPM4:
+1. The start bit edge fires PORT1_VECTOR, the DCO restarts within a few microseconds
+2. Port_1 ISR starts Timer0_A from SMCLK and sets TA0CCR1 directly to the middle of D0,
+   compensating the wake-up and ISR entry time, then hands P1.2 back to Timer0_A.CCI1A
+3. The first byte is received in compare mode by the usual RXD ISR, later bytes by capturing the start bit
+4. TA0CCR2 counts the idle time, after UART_IDLE_TIMEOUT ms without traffic the listener goes back to LPM4
+Clocks and TX come from the driver, build with ../driver/system.c ../driver/uart.c and without UART_RX:
+the receiver stays here, the driver's one keeps Timer0_A running and has no GPIO wake-up or idle timeout.
+*/
+#include "msp430.h"
+#include "../driver/system.h"
+#include "../driver/uart.h"
+
+#ifdef UART_RX
+#error "softwareUART_wakeup.c has its own receiver on TIMER0_A1_VECTOR, build without -DUART_RX"
+#endif
+
+#define UART_TBIT_DIV_2 (UART_TBIT / 2)
+#define UART_WAKE_TICKS 12      // DCO start + interrupt entry + ISR prologue until TACLR, in SMCLK cycles
+#define UART_IDLE_TICK 50000    // 50 ms of SMCLK between two idle checks
+#define UART_IDLE_TIMEOUT 40    // 40 * 50 ms = 2 s without traffic -> back to LPM4
+
+unsigned char rxBuffer; // Received UART character
+volatile unsigned char rxReady = 0; // New character in rxBuffer
+volatile unsigned char listening = 0; // 1 while the timer handles RXD, 0 while parked in LPM4
+volatile unsigned char idleCount;
+
+void TimerA_UART_park(void);
+
+void configP1_UART(void){
+    P1OUT = 0x00;       // Initialize all GPIO
+    P1DIR = 0xFF & ~UART_RXD; // Set pins to output
+    TimerA_UART_init(); // TXD from Timer0_A.OUT0, RXD starts as GPIO (TimerA_UART_park)
+}
+
+void main(void){
+    configWDT();
+    configClocks();
+    configP1_UART();
+    TimerA_UART_park();
+
+    for (;;) {
+        __disable_interrupt(); // Check and sleep atomically
+        if (rxReady) {
+            rxReady = 0;
+            __enable_interrupt();
+            TimerA_UART_tx(rxBuffer); // Echo received character
+        } else if (listening) {
+            __bis_SR_register(LPM0_bits + GIE); // Timer0_A needs SMCLK
+        } else {
+            __bis_SR_register(LPM4_bits + GIE); // All clocks off until the next start bit
+        }
+    }
+}
+
+// Stop Timer0_A and wait for the start bit on the RXD GPIO interrupt
+void TimerA_UART_park(void) {
+    TA0CTL = 0;                 // Stop the timer, SMCLK may be switched off
+    TA0CCTL0 = OUT;             // TXD idle as '1'
+    TA0CCTL1 = 0;
+    TA0CCTL2 = 0;
+    P1SEL &= ~UART_RXD;         // RXD as GPIO input
+    P1IES |= UART_RXD;          // Falling edge = start bit
+    P1IFG &= ~UART_RXD;
+    P1IE |= UART_RXD;
+    listening = 0;
+}
+
+#pragma vector = PORT1_VECTOR // Start bit while parked
+__interrupt void Port_1(void) {
+    if (P1IFG & UART_RXD) {
+        TA0CTL = TASSEL_2 + MC_2 + TACLR; // SMCLK, continuous mode, TAR = 0 at the start bit
+        TA0CCR1 = UART_TBIT + UART_TBIT_DIV_2 - UART_WAKE_TICKS; // To middle of D0
+        TA0CCTL1 = SCS + CCIE;  // Compare mode, latch CCI1A in SCCI
+        P1IE &= ~UART_RXD;
+        P1IFG &= ~UART_RXD;
+        P1SEL |= UART_RXD;      // Hand RXD over to Timer0_A.CCI1A before D0
+        TA0CCR2 = UART_IDLE_TICK;
+        TA0CCTL2 = CCIE;        // Idle timeout
+        idleCount = UART_IDLE_TIMEOUT;
+        listening = 1;
+        __bic_SR_register_on_exit(SCG1 + SCG0 + OSCOFF); // Keep SMCLK on, CPU stays off (LPM0)
+    }
+}
+
+#pragma vector = TIMER0_A1_VECTOR // RXD and idle timeout interrupt
+__interrupt void Timer_A1_ISR(void) {
+    static unsigned char rxBitCnt = 8;
+    static unsigned char rxData = 0;
+
+    switch (__even_in_range(TA0IV, TA0IV_TAIFG)) {
+        case TA0IV_TACCR1:     // TACCR1 CCIFG - UART RXD
+            TA0CCR1 += UART_TBIT;// Set TACCR1 for next int
+            idleCount = UART_IDLE_TIMEOUT; // Traffic, restart the idle timeout
+
+            if (TA0CCTL1 & CAP) { // On start bit edge
+                TA0CCTL1 &= ~CAP;   // Switch to compare mode
+                TA0CCR1 += UART_TBIT_DIV_2;// To middle of D0
+            } else {             // Get next data bit
+                rxData >>= 1;
+                if (TA0CCTL1 & SCCI) { // Get bit from latch
+                    rxData |= 0x80;
+                }
+
+                rxBitCnt--;
+                if (rxBitCnt == 0) {  // All bits RXed?
+                    rxBuffer = rxData;  // Store in global
+                    rxReady = 1;
+                    rxBitCnt = 8;       // Re-load bit counter
+                    TA0CCTL1 = SCS + CM1 + CAP + CCIE; // Switch to capture for the next start bit
+                    __bic_SR_register_on_exit(LPM4_bits);  // Wake up main loop
+                }
+            }
+            break;
+        case TA0IV_TACCR2:     // TACCR2 CCIFG - idle timeout
+            TA0CCR2 += UART_IDLE_TICK;
+            if (!uartTxIdle(&uart0)) {  // Still transmitting
+                idleCount = UART_IDLE_TIMEOUT;
+            } else if (--idleCount == 0) {
+                TimerA_UART_park();
+                __bic_SR_register_on_exit(LPM4_bits); // Let main loop go down to LPM4
+            }
+            break;
+    }
+}